@@ -0,0 +1,188 @@
+#!/usr/bin/env python3
+# bench.py - Headless startup/frame time benchmark for BENCH=1 builds.
+#
+# Serves each build directory with the cross-origin isolation headers, loads
+# it in headless Chrome/Chromium and scrapes the "BENCH ..." console lines
+# printed by src/utils/frame_stats.cpp, then prints one table row per build.
+#
+# Usage: python3 bench.py [--browser PATH] [--reports N] [--timeout S]
+#                         name=directory [name=directory ...]
+#
+# The browser is taken from --browser, $CHROME, or the first of chromium,
+# chromium-browser, google-chrome, google-chrome-stable on PATH. Without one,
+# only the Wasm sizes are reported.
+
+import argparse
+import os
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+import threading
+import time
+from functools import partial
+from http.server import ThreadingHTTPServer
+
+from serve import CrossOriginIsolatedHandler
+
+BROWSERS = ["chromium", "chromium-browser", "google-chrome", "google-chrome-stable"]
+
+STARTUP_RE = re.compile(r"BENCH startup page=([\d.]+)ms main=([\d.]+)ms")
+FRAMES_RE = re.compile(r"BENCH frames=(\d+) avg=([\d.]+)ms max=([\d.]+)ms")
+
+
+def find_browser(requested):
+    if requested:
+        return requested
+    if os.environ.get("CHROME"):
+        return os.environ["CHROME"]
+    for name in BROWSERS:
+        path = shutil.which(name)
+        if path:
+            return path
+    return None
+
+
+class QuietHandler(CrossOriginIsolatedHandler):
+    # Keep the output to the benchmark table
+    def log_message(self, format, *args):
+        pass
+
+
+def serve(directory):
+    handler = partial(QuietHandler, directory=directory)
+    server = ThreadingHTTPServer(("127.0.0.1", 0), handler)
+    threading.Thread(target=server.serve_forever, daemon=True).start()
+    return server
+
+
+def run_build(browser, directory, reports, timeout):
+    """Load one build and return (startup, [frame reports]) from its console."""
+    server = serve(directory)
+    url = f"http://127.0.0.1:{server.server_address[1]}/index.html"
+    profile = tempfile.mkdtemp(prefix="ramla-bench-")
+
+    command = [
+        browser,
+        "--headless=new",
+        "--no-first-run",
+        "--no-default-browser-check",
+        f"--user-data-dir={profile}",
+        "--enable-logging=stderr",
+        "--v=0",
+        # WebGL without a GPU
+        "--use-angle=swiftshader",
+        "--enable-unsafe-swiftshader",
+        # Keep requestAnimationFrame at full rate in the background
+        "--disable-background-timer-throttling",
+        "--disable-renderer-backgrounding",
+        "--window-size=1280,720",
+        url,
+    ]
+
+    startup = None
+    frames = []
+    process = subprocess.Popen(command, stdout=subprocess.DEVNULL,
+                               stderr=subprocess.PIPE, text=True, errors="replace")
+    deadline = time.monotonic() + timeout
+
+    # Read the console on a thread so the timeout holds even when the browser
+    # goes quiet
+    lines = []
+
+    def read():
+        for line in iter(process.stderr.readline, ""):
+            lines.append(line)
+
+    reader = threading.Thread(target=read, daemon=True)
+    reader.start()
+
+    seen = 0
+    try:
+        while time.monotonic() < deadline and process.poll() is None:
+            time.sleep(0.1)
+            for line in lines[seen:]:
+                match = STARTUP_RE.search(line)
+                if match and startup is None:
+                    startup = (float(match.group(1)), float(match.group(2)))
+                match = FRAMES_RE.search(line)
+                if match:
+                    frames.append((float(match.group(2)), float(match.group(3))))
+            seen = len(lines)
+            if startup is not None and len(frames) >= reports:
+                break
+    finally:
+        process.terminate()
+        try:
+            process.wait(timeout=5)
+        except subprocess.TimeoutExpired:
+            process.kill()
+        server.shutdown()
+        shutil.rmtree(profile, ignore_errors=True)
+
+    return startup, frames
+
+
+def size(directory, name):
+    path = os.path.join(directory, name)
+    return os.path.getsize(path) if os.path.exists(path) else None
+
+
+def cell(value, fmt="{:.2f}"):
+    return "-" if value is None else fmt.format(value)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Headless startup/frame time benchmark for BENCH=1 builds")
+    parser.add_argument("builds", nargs="+", help="name=directory")
+    parser.add_argument("--browser")
+    parser.add_argument("--reports", type=int, default=3,
+                        help="frame time reports to average (600 frames each)")
+    parser.add_argument("--timeout", type=float, default=90.0,
+                        help="seconds to wait for each build")
+    args = parser.parse_args()
+
+    browser = find_browser(args.browser)
+    if browser is None:
+        print("No Chrome/Chromium found (set CHROME or --browser); "
+              "reporting sizes only", file=sys.stderr)
+
+    rows = []
+    for build in args.builds:
+        name, _, directory = build.partition("=")
+        if not directory:
+            parser.error(f"expected name=directory, got {build!r}")
+
+        startup, frames = (None, [])
+        if browser is not None:
+            startup, frames = run_build(browser, directory, args.reports,
+                                        args.timeout)
+            if startup is None or not frames:
+                print(f"{name}: no BENCH output within {args.timeout:.0f}s "
+                      "(was it built with BENCH=1?)", file=sys.stderr)
+
+        # Frame times: mean of the per-report averages, worst of the maxima
+        average = sum(f[0] for f in frames) / len(frames) if frames else None
+        worst = max(f[1] for f in frames) if frames else None
+        rows.append([
+            name,
+            cell(size(directory, "main.wasm"), "{:d}"),
+            cell(size(directory, "main.js"), "{:d}"),
+            cell(startup[0] if startup else None, "{:.1f}"),
+            cell(startup[1] if startup else None, "{:.1f}"),
+            cell(average, "{:.3f}"),
+            cell(worst, "{:.3f}"),
+        ])
+
+    header = ["build", "main.wasm (B)", "main.js (B)", "page->frame (ms)",
+              "main->frame (ms)", "frame avg (ms)", "frame max (ms)"]
+    print("| " + " | ".join(header) + " |")
+    print("|" + "|".join("---" for _ in header) + "|")
+    for row in rows:
+        print("| " + " | ".join(row) + " |")
+
+
+if __name__ == "__main__":
+    main()
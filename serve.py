@@ -0,0 +1,24 @@
+#!/usr/bin/env python3
+# serve.py - Static file server with the cross-origin isolation headers that
+# SharedArrayBuffer (and therefore Emscripten pthreads) requires.
+#
+# Usage: python3 serve.py [port] [directory]
+
+import sys
+from functools import partial
+from http.server import SimpleHTTPRequestHandler, ThreadingHTTPServer
+
+
+class CrossOriginIsolatedHandler(SimpleHTTPRequestHandler):
+    def end_headers(self):
+        self.send_header("Cross-Origin-Opener-Policy", "same-origin")
+        self.send_header("Cross-Origin-Embedder-Policy", "require-corp")
+        super().end_headers()
+
+
+if __name__ == "__main__":
+    port = int(sys.argv[1]) if len(sys.argv) > 1 else 9999
+    directory = sys.argv[2] if len(sys.argv) > 2 else "."
+    handler = partial(CrossOriginIsolatedHandler, directory=directory)
+    print(f"Serving {directory} at http://localhost:{port}")
+    ThreadingHTTPServer(("", port), handler).serve_forever()
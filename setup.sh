@@ -117,8 +117,12 @@ cd raylib/src
 # Source Emscripten environment
 source ../../emsdk/emsdk_env.sh
 
-# Build raylib for web platform
-make PLATFORM=PLATFORM_WEB
+# Build raylib for web platform (pthreads for the image decode workers, JPEG
+# decoding enabled). The flags are recorded so the Makefile and CMake rebuild
+# raylib if they ever change.
+RAYLIB_CFLAGS="-pthread -DSUPPORT_FILETYPE_JPG=1"
+echo "$RAYLIB_CFLAGS" > libraylib.web.cflags
+make PLATFORM=PLATFORM_WEB CUSTOM_CFLAGS="$RAYLIB_CFLAGS"
 
 print_success "Raylib built successfully for WebAssembly!"
 cd ../..
@@ -18,6 +18,9 @@ struct Button {
   float borderRadius; // 0.0f = no rounding, 1.0f = fully rounded
   int segments; // Number of segments for rounded corners (16 is good default)
   Font *font;   // Pointer to font (nullptr = use default font)
+  int backgroundTween; // Color tween handle for state transitions (0 = none)
+  int borderTween;     // Color tween handle for border transitions (0 = none)
+  const Style *style;  // Precompiled style (nullptr = use the colors above)
 };
 
 struct ButtonState {
@@ -28,14 +31,11 @@ struct ButtonState {
 
 bool isPointInsideButton(Button *btn, Vector2 point) {
   // Convert logical coordinates to physical for hit testing
-  float scale = getScaleFactor();
-  float physicalX = roundf(btn->x * scale);
-  float physicalY = roundf(btn->y * scale);
-  float physicalWidth = roundf(btn->width * scale);
-  float physicalHeight = roundf(btn->height * scale);
+  Rectangle physical = scaleRectRound(
+      (Rectangle){btn->x, btn->y, btn->width, btn->height}, getScaleFactor());
 
-  return point.x >= physicalX && point.x <= physicalX + physicalWidth &&
-         point.y >= physicalY && point.y <= physicalY + physicalHeight;
+  return point.x >= physical.x && point.x <= physical.x + physical.width &&
+         point.y >= physical.y && point.y <= physical.y + physical.height;
 }
 
 bool isButtonHovered(Button *btn) {
@@ -65,6 +65,21 @@ Color adjustColor(Color color, float factor) {
   return newColor;
 }
 
+// Take colors, metrics and font from a precompiled style
+void applyButtonStyle(Button *btn, const Style *style) {
+  btn->style = style;
+  btn->backgroundColor = style->background[STYLE_NORMAL];
+  btn->hoverColor = style->background[STYLE_HOVER];
+  btn->pressedColor = style->background[STYLE_PRESSED];
+  btn->borderColor = style->border[STYLE_NORMAL];
+  btn->textColor = style->text;
+  btn->borderWidth = style->borderWidth;
+  btn->borderRadius = style->borderRadius;
+  btn->segments = style->segments;
+  btn->fontSize = style->fontSize;
+  btn->font = style->font.texture.id > 0 ? (Font *)&style->font : nullptr;
+}
+
 ButtonState button(Button *btn) {
   ButtonState state = {
       .hovered = isButtonHovered(btn),
@@ -73,10 +88,12 @@ ButtonState button(Button *btn) {
 
   // Convert logical coordinates to physical coordinates
   float scale = getScaleFactor();
-  float physicalX = roundf(btn->x * scale);
-  float physicalY = roundf(btn->y * scale);
-  float physicalWidth = roundf(btn->width * scale);
-  float physicalHeight = roundf(btn->height * scale);
+  Rectangle physical = scaleRectRound(
+      (Rectangle){btn->x, btn->y, btn->width, btn->height}, scale);
+  float physicalX = physical.x;
+  float physicalY = physical.y;
+  float physicalWidth = physical.width;
+  float physicalHeight = physical.height;
   float physicalBorderWidth = fmaxf(1.0f, roundf(btn->borderWidth * scale));
   float physicalFontSize = roundf(btn->fontSize * scale);
 
@@ -84,7 +101,14 @@ ButtonState button(Button *btn) {
   Color currentColor = btn->backgroundColor;
   Color currentBorderColor = btn->borderColor;
 
-  if (state.pressed) {
+  if (btn->style != nullptr) {
+    // State variants were resolved when the style was registered
+    int variant = state.pressed   ? STYLE_PRESSED
+                  : state.hovered ? STYLE_HOVER
+                                  : STYLE_NORMAL;
+    currentColor = btn->style->background[variant];
+    currentBorderColor = btn->style->border[variant];
+  } else if (state.pressed) {
     currentColor = btn->pressedColor;
     // Make border darker when pressed for "inset" effect
     currentBorderColor = adjustColor(btn->pressedColor, 0.6f);
@@ -94,6 +118,17 @@ ButtonState button(Button *btn) {
     currentBorderColor = adjustColor(btn->hoverColor, 0.8f);
   }
 
+  // Ease towards the state colors instead of switching instantly when the
+  // caller supplied transition tweens
+  if (btn->backgroundTween != 0 &&
+      retargetColor(btn->backgroundTween, currentColor)) {
+    currentColor = getTweenColor(btn->backgroundTween, currentColor);
+  }
+  if (btn->borderTween != 0 &&
+      retargetColor(btn->borderTween, currentBorderColor)) {
+    currentBorderColor = getTweenColor(btn->borderTween, currentBorderColor);
+  }
+
   // Draw the border first (if border width > 0)
   if (physicalBorderWidth > 0.0f) {
     Rectangle borderRect = {physicalX - physicalBorderWidth,
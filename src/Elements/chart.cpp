@@ -0,0 +1,356 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <raylib.h>
+#include <rlgl.h>
+#include <vector>
+
+// Streaming time-series chart. Each series keeps its samples in a ring buffer
+// plus a min/max pyramid built incrementally as samples arrive: level k holds
+// the min and max of every block of 4^k samples. Drawing picks the coarsest
+// level that still has at least one block per pixel column, so the work (and
+// the number of line segments) is O(width) no matter how many samples are in
+// view. Zooming and panning just pick a different level.
+
+const int CHART_LOD_SHIFT = 2; // 4 samples per block per level
+const size_t CHART_DEFAULT_CAPACITY = 1 << 20;
+
+// Vertices per rlBegin/rlEnd chunk - keeps each chunk inside raylib's batch
+const int CHART_VERTEX_CHUNK = 2048;
+
+struct ChartSeries {
+  std::vector<float> samples; // ring buffer, power of two capacity
+  size_t mask;                // capacity - 1
+  uint64_t count;             // samples ever appended
+  // levelMin[k - 1]/levelMax[k - 1] are the level k blocks, ring indexed
+  std::vector<std::vector<float>> levelMin;
+  std::vector<std::vector<float>> levelMax;
+  Color color;
+};
+
+struct Chart {
+  std::vector<ChartSeries> series;
+  bool follow;          // keep the newest samples in view
+  double viewStart;     // first sample index in view (when not following)
+  double viewSamples;   // samples across the chart width
+  bool autoScale;       // fit the y range to the visible data
+  float minValue;       // fixed y range when autoScale is off
+  float maxValue;
+  Color background;
+
+  // Scratch buffers reused between frames
+  std::vector<float> columnMin; // [series][column]
+  std::vector<float> columnMax;
+  std::vector<float> columnY; // screen y of one series' mins, then maxes
+  std::vector<Vector2> vertices;
+};
+
+// Set when samples are appended, so streaming charts keep the main loop at
+// full rate (see chartsActive)
+static bool chartsDirty = false;
+
+Chart makeChart(double viewSamples = 1000.0) {
+  Chart chart = {};
+  chart.follow = true;
+  chart.viewSamples = viewSamples;
+  chart.autoScale = true;
+  chart.minValue = 0.0f;
+  chart.maxValue = 1.0f;
+  chart.background = (Color){20, 20, 20, 255};
+  return chart;
+}
+
+// Add a series holding up to `capacity` samples (rounded up to a power of
+// two). Returns its index.
+int addChartSeries(Chart *chart, size_t capacity, Color color) {
+  size_t size = 4;
+  while (size < capacity) {
+    size <<= 1;
+  }
+
+  ChartSeries series = {};
+  series.samples.assign(size, 0.0f);
+  series.mask = size - 1;
+  series.color = color;
+
+  for (size_t blocks = size >> CHART_LOD_SHIFT; blocks >= 1;
+       blocks >>= CHART_LOD_SHIFT) {
+    series.levelMin.emplace_back(blocks, 0.0f);
+    series.levelMax.emplace_back(blocks, 0.0f);
+  }
+
+  chart->series.push_back(std::move(series));
+  return (int)chart->series.size() - 1;
+}
+
+// Append samples, updating one block per pyramid level for each
+void appendChartSamples(Chart *chart, int seriesIndex, const float *values,
+                        size_t count) {
+  if (seriesIndex < 0 || seriesIndex >= (int)chart->series.size()) {
+    return;
+  }
+
+  ChartSeries &series = chart->series[seriesIndex];
+  size_t levels = series.levelMin.size();
+  chartsDirty = chartsDirty || count > 0;
+
+  for (size_t i = 0; i < count; i++) {
+    uint64_t index = series.count++;
+    float value = values[i];
+    series.samples[index & series.mask] = value;
+
+    for (size_t level = 0; level < levels; level++) {
+      int shift = (int)(level + 1) * CHART_LOD_SHIFT;
+      size_t slot = (size_t)((index >> shift) & (series.mask >> shift));
+      float &blockMin = series.levelMin[level][slot];
+      float &blockMax = series.levelMax[level][slot];
+
+      // First sample of a block starts it over
+      if ((index & ((1ull << shift) - 1)) == 0) {
+        blockMin = blockMax = value;
+      } else {
+        blockMin = fminf(blockMin, value);
+        blockMax = fmaxf(blockMax, value);
+      }
+    }
+  }
+}
+
+// Whether any chart received samples since the last call. Called once per
+// frame by the idle throttle.
+bool chartsActive() {
+  bool active = chartsDirty;
+  chartsDirty = false;
+  return active;
+}
+
+// Show `samples` samples starting at `start`, and stop following new data
+void setChartView(Chart *chart, double start, double samples) {
+  chart->follow = false;
+  chart->viewStart = start;
+  chart->viewSamples = fmax(samples, 2.0);
+}
+
+// Show the newest `samples` samples and keep following new data
+void followChart(Chart *chart, double samples) {
+  chart->follow = true;
+  chart->viewSamples = fmax(samples, 2.0);
+}
+
+// Min/max of samples [first, last] of a series, reading the coarsest level
+// whose blocks fit inside the range at both ends
+static void seriesRangeMinMax(const ChartSeries &series, uint64_t first,
+                              uint64_t last, int level, float *outMin,
+                              float *outMax) {
+  float lo = INFINITY;
+  float hi = -INFINITY;
+  uint64_t index = first;
+
+  while (index <= last) {
+    // Use a level block when one is aligned here and ends inside the range
+    int useLevel = level;
+    while (useLevel > 0) {
+      int shift = useLevel * CHART_LOD_SHIFT;
+      uint64_t blockSize = 1ull << shift;
+      if ((index & (blockSize - 1)) == 0 && index + blockSize - 1 <= last) {
+        break;
+      }
+      useLevel--;
+    }
+
+    if (useLevel == 0) {
+      float value = series.samples[index & series.mask];
+      lo = fminf(lo, value);
+      hi = fmaxf(hi, value);
+      index++;
+    } else {
+      int shift = useLevel * CHART_LOD_SHIFT;
+      size_t slot = (size_t)((index >> shift) & (series.mask >> shift));
+      lo = fminf(lo, series.levelMin[useLevel - 1][slot]);
+      hi = fmaxf(hi, series.levelMax[useLevel - 1][slot]);
+      index += 1ull << shift;
+    }
+  }
+
+  *outMin = lo;
+  *outMax = hi;
+}
+
+// Submit line segments (vertex pairs) in chunks that fit the render batch
+static void submitChartLines(const Vector2 *vertices, size_t count,
+                             Color color) {
+  for (size_t start = 0; start < count; start += CHART_VERTEX_CHUNK) {
+    size_t end = std::min(count, start + CHART_VERTEX_CHUNK);
+    rlCheckRenderBatchLimit((int)(end - start));
+
+    rlBegin(RL_LINES);
+    rlColor4ub(color.r, color.g, color.b, color.a);
+    for (size_t i = start; i < end; i++) {
+      rlVertex2f(vertices[i].x, vertices[i].y);
+    }
+    rlEnd();
+  }
+}
+
+// Wheel zooms around the cursor, left drag pans. Either stops following.
+static void handleChartInput(Chart *chart, Rectangle physicalBounds,
+                             double viewStart) {
+  Vector2 mouse = GetMousePosition();
+  bool inside = mouse.x >= physicalBounds.x &&
+                mouse.x <= physicalBounds.x + physicalBounds.width &&
+                mouse.y >= physicalBounds.y &&
+                mouse.y <= physicalBounds.y + physicalBounds.height;
+  if (!inside) {
+    return;
+  }
+
+  double samplesPerPixel = chart->viewSamples / physicalBounds.width;
+
+  float wheel = GetMouseWheelMove();
+  if (wheel != 0.0f) {
+    double anchor = viewStart + (mouse.x - physicalBounds.x) * samplesPerPixel;
+    double zoom = pow(0.85, wheel);
+    double samples = chart->viewSamples * zoom;
+    setChartView(chart, anchor - (anchor - viewStart) * zoom, samples);
+    return;
+  }
+
+  if (IsMouseButtonDown(MOUSE_BUTTON_LEFT)) {
+    Vector2 delta = GetMouseDelta();
+    if (delta.x != 0.0f) {
+      setChartView(chart, viewStart - delta.x * samplesPerPixel,
+                   chart->viewSamples);
+    }
+  }
+}
+
+// Draw the chart into logical `bounds`. With `interactive`, the mouse wheel
+// zooms and dragging pans.
+void drawChart(Chart *chart, Rectangle bounds, bool interactive = true) {
+  // Convert logical coordinates to physical coordinates
+  float scale = getScaleFactor();
+  Rectangle physical = scaleRectRound(bounds, scale);
+  int columns = (int)physical.width;
+  if (columns < 2 || physical.height < 1.0f) {
+    return;
+  }
+
+  DrawRectangleRec(physical, chart->background);
+
+  // Newest sample across all series, for following and clamping
+  uint64_t newest = 0;
+  for (const ChartSeries &series : chart->series) {
+    newest = std::max(newest, series.count);
+  }
+
+  double viewStart = chart->follow ? (double)newest - chart->viewSamples
+                                   : chart->viewStart;
+  if (interactive) {
+    handleChartInput(chart, physical, viewStart);
+    if (!chart->follow) {
+      viewStart = chart->viewStart;
+    }
+  }
+
+  double samplesPerColumn = chart->viewSamples / columns;
+
+  // Coarsest level with at least one block per column
+  int level = 0;
+  while (level < 16 &&
+         (double)(1ull << ((level + 1) * CHART_LOD_SHIFT)) <= samplesPerColumn) {
+    level++;
+  }
+
+  size_t seriesCount = chart->series.size();
+  chart->columnMin.assign(seriesCount * columns, NAN);
+  chart->columnMax.assign(seriesCount * columns, NAN);
+
+  // Pass 1: per-column min/max of every series
+  float lo = INFINITY;
+  float hi = -INFINITY;
+  for (size_t s = 0; s < seriesCount; s++) {
+    const ChartSeries &series = chart->series[s];
+    if (series.count == 0) {
+      continue;
+    }
+
+    uint64_t oldest = series.count > series.samples.size()
+                          ? series.count - series.samples.size()
+                          : 0;
+    int seriesLevel = std::min(level, (int)series.levelMin.size());
+    float *colMin = &chart->columnMin[s * columns];
+    float *colMax = &chart->columnMax[s * columns];
+
+    for (int c = 0; c < columns; c++) {
+      double first = floor(viewStart + c * samplesPerColumn);
+      double last = floor(viewStart + (c + 1) * samplesPerColumn) - 1.0;
+      // Zoomed in past one sample per column: sample the nearest one
+      if (last < first) {
+        last = first;
+      }
+      if (last < (double)oldest || first >= (double)series.count) {
+        continue;
+      }
+      first = fmax(first, (double)oldest);
+      last = fmin(last, (double)series.count - 1);
+
+      seriesRangeMinMax(series, (uint64_t)first, (uint64_t)last, seriesLevel,
+                        &colMin[c], &colMax[c]);
+      lo = fminf(lo, colMin[c]);
+      hi = fmaxf(hi, colMax[c]);
+    }
+  }
+
+  if (!chart->autoScale || lo > hi) {
+    lo = chart->minValue;
+    hi = chart->maxValue;
+  }
+  if (hi - lo < 1e-6f) {
+    hi = lo + 1.0f;
+  }
+
+  // Pass 2: one zig-zag through each column's min and max - two segments per
+  // column, so the envelope and its connections are both covered
+  float yScale = physical.height / (hi - lo);
+  float bottom = physical.y + physical.height;
+
+  BeginScissorMode((int)physical.x, (int)physical.y, (int)physical.width,
+                   (int)physical.height);
+
+  chart->columnY.resize(2 * (size_t)columns);
+  chart->vertices.resize(4 * (size_t)columns);
+  float *lowY = chart->columnY.data();
+  float *highY = lowY + columns;
+
+  for (size_t s = 0; s < seriesCount; s++) {
+    // Map the whole envelope to screen space in one vectorized pass
+    mapLinear(&chart->columnMin[s * columns], lowY, columns, lo, yScale,
+              bottom);
+    mapLinear(&chart->columnMax[s * columns], highY, columns, lo, yScale,
+              bottom);
+
+    // Each run of columns without gaps becomes one zig-zag, built 4 columns
+    // at a time
+    Vector2 *vertices = chart->vertices.data();
+    size_t vertexCount = 0;
+    int c = 0;
+    while (c < columns) {
+      if (std::isnan(lowY[c])) {
+        c++;
+        continue;
+      }
+      int runStart = c;
+      while (c < columns && !std::isnan(lowY[c])) {
+        c++;
+      }
+      vertexCount += buildColumnZigZag(
+          physical.x + runStart + 0.5f, lowY + runStart, highY + runStart,
+          c - runStart, vertices + vertexCount);
+    }
+
+    submitChartLines(vertices, vertexCount, chart->series[s].color);
+  }
+
+  EndScissorMode();
+}
@@ -0,0 +1,397 @@
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <raylib.h>
+#include <vector>
+
+// Easing curves available to tweens
+enum class Easing : uint8_t {
+  Linear,
+  InQuad,
+  OutQuad,
+  InOutQuad,
+  InCubic,
+  OutCubic,
+  InOutCubic,
+  OutBack
+};
+
+// What a tween track animates - decides how its lanes are read back
+enum class TweenKind : uint8_t { Float, Color, Rect };
+
+// Every track owns a fixed block of float lanes so the interpolation pass is a
+// single flat loop over contiguous arrays (floats use lane 0, colors use
+// r/g/b/a, rects use x/y/width/height)
+constexpr int TWEEN_LANES = 4;
+
+// Handles pack a slot index (low 16 bits) and a generation (high bits) so a
+// stale handle from a cancelled tween never aliases a reused slot. 0 is never
+// a valid handle.
+constexpr uint32_t TWEEN_INDEX_BITS = 16;
+constexpr uint32_t TWEEN_INDEX_MASK = (1u << TWEEN_INDEX_BITS) - 1;
+constexpr uint32_t TWEEN_MAX_GENERATION = 0x7FFF;
+
+// Structure-of-arrays tween storage. Track arrays are indexed by slot, lane
+// arrays by slot * TWEEN_LANES + lane.
+struct AnimationManager {
+  // Per-track data
+  std::vector<float> elapsed;  // seconds since start/retarget
+  std::vector<float> duration; // seconds, always > 0
+  std::vector<float> progress; // normalized 0..1, refreshed every update
+  std::vector<Easing> easing;
+  std::vector<TweenKind> kind;
+  std::vector<uint16_t> generation;
+  std::vector<uint8_t> alive; // 0 = slot is on the free list
+  std::vector<uint16_t> freeSlots;
+
+  // Per-lane data
+  std::vector<float> from;
+  std::vector<float> to;
+  std::vector<float> eased; // track's eased progress broadcast to its lanes
+  std::vector<float> value;
+
+  int runningTracks; // tracks that have not reached their target yet
+};
+
+static AnimationManager animationManager = {};
+
+static float applyEasing(Easing easing, float t) {
+  switch (easing) {
+  case Easing::Linear:
+    return t;
+  case Easing::InQuad:
+    return t * t;
+  case Easing::OutQuad:
+    return t * (2.0f - t);
+  case Easing::InOutQuad:
+    return t < 0.5f ? 2.0f * t * t : -1.0f + (4.0f - 2.0f * t) * t;
+  case Easing::InCubic:
+    return t * t * t;
+  case Easing::OutCubic: {
+    float u = t - 1.0f;
+    return u * u * u + 1.0f;
+  }
+  case Easing::InOutCubic: {
+    if (t < 0.5f) {
+      return 4.0f * t * t * t;
+    }
+    float u = 2.0f * t - 2.0f;
+    return 0.5f * u * u * u + 1.0f;
+  }
+  case Easing::OutBack: {
+    const float c1 = 1.70158f;
+    const float c3 = c1 + 1.0f;
+    float u = t - 1.0f;
+    return 1.0f + c3 * u * u * u + c1 * u * u;
+  }
+  }
+  return t;
+}
+
+// Parse an easing name as used from Lua ("linear", "outCubic", ...). Unknown
+// names fall back to OutCubic, which suits most UI transitions.
+Easing easingFromName(const char *name) {
+  if (name == nullptr) {
+    return Easing::OutCubic;
+  }
+
+  static const struct {
+    const char *name;
+    Easing easing;
+  } easingNames[] = {
+      {"linear", Easing::Linear},       {"inQuad", Easing::InQuad},
+      {"outQuad", Easing::OutQuad},     {"inOutQuad", Easing::InOutQuad},
+      {"inCubic", Easing::InCubic},     {"outCubic", Easing::OutCubic},
+      {"inOutCubic", Easing::InOutCubic}, {"outBack", Easing::OutBack},
+  };
+
+  for (const auto &entry : easingNames) {
+    if (strcmp(entry.name, name) == 0) {
+      return entry.easing;
+    }
+  }
+  return Easing::OutCubic;
+}
+
+static int tweenSlot(int handle) {
+  if (handle <= 0) {
+    return -1;
+  }
+
+  uint32_t slot = (uint32_t)handle & TWEEN_INDEX_MASK;
+  uint32_t generation = (uint32_t)handle >> TWEEN_INDEX_BITS;
+  if (slot >= animationManager.generation.size() ||
+      !animationManager.alive[slot] ||
+      animationManager.generation[slot] != generation) {
+    return -1;
+  }
+  return (int)slot;
+}
+
+static int allocateTweenSlot() {
+  AnimationManager &am = animationManager;
+
+  if (!am.freeSlots.empty()) {
+    int slot = am.freeSlots.back();
+    am.freeSlots.pop_back();
+    return slot;
+  }
+
+  size_t slot = am.generation.size();
+  if (slot > TWEEN_INDEX_MASK) {
+    return -1;
+  }
+
+  am.elapsed.push_back(0.0f);
+  am.duration.push_back(1.0f);
+  am.progress.push_back(1.0f);
+  am.easing.push_back(Easing::Linear);
+  am.kind.push_back(TweenKind::Float);
+  am.generation.push_back(0);
+  am.alive.push_back(0);
+  am.from.resize(am.from.size() + TWEEN_LANES, 0.0f);
+  am.to.resize(am.to.size() + TWEEN_LANES, 0.0f);
+  am.eased.resize(am.eased.size() + TWEEN_LANES, 1.0f);
+  am.value.resize(am.value.size() + TWEEN_LANES, 0.0f);
+  return (int)slot;
+}
+
+// Start a tween of `kind` from `from` to `to` (TWEEN_LANES floats each).
+// Returns a handle, or 0 if the tween pool is exhausted.
+int startTween(TweenKind kind, const float *from, const float *to,
+               float duration, Easing easing) {
+  AnimationManager &am = animationManager;
+
+  int slot = allocateTweenSlot();
+  if (slot < 0) {
+    return 0;
+  }
+
+  // Bump the generation so handles to the slot's previous owner go stale
+  uint16_t generation = am.generation[slot] + 1;
+  if (generation > TWEEN_MAX_GENERATION) {
+    generation = 1;
+  }
+  am.generation[slot] = generation;
+  am.alive[slot] = 1;
+
+  am.elapsed[slot] = 0.0f;
+  am.duration[slot] = fmaxf(duration, 0.0001f);
+  am.progress[slot] = 0.0f;
+  am.easing[slot] = easing;
+  am.kind[slot] = kind;
+
+  for (int lane = 0; lane < TWEEN_LANES; lane++) {
+    int i = slot * TWEEN_LANES + lane;
+    am.from[i] = from[lane];
+    am.to[i] = to[lane];
+    am.eased[i] = 0.0f;
+    am.value[i] = from[lane];
+  }
+
+  am.runningTracks++;
+  return (int)(((uint32_t)generation << TWEEN_INDEX_BITS) | (uint32_t)slot);
+}
+
+int tweenFloat(float from, float to, float duration,
+               Easing easing = Easing::OutCubic) {
+  float fromLanes[TWEEN_LANES] = {from, 0.0f, 0.0f, 0.0f};
+  float toLanes[TWEEN_LANES] = {to, 0.0f, 0.0f, 0.0f};
+  return startTween(TweenKind::Float, fromLanes, toLanes, duration, easing);
+}
+
+int tweenColor(Color from, Color to, float duration,
+               Easing easing = Easing::OutCubic) {
+  float fromLanes[TWEEN_LANES] = {(float)from.r, (float)from.g, (float)from.b,
+                                  (float)from.a};
+  float toLanes[TWEEN_LANES] = {(float)to.r, (float)to.g, (float)to.b,
+                                (float)to.a};
+  return startTween(TweenKind::Color, fromLanes, toLanes, duration, easing);
+}
+
+int tweenRect(Rectangle from, Rectangle to, float duration,
+              Easing easing = Easing::OutCubic) {
+  float fromLanes[TWEEN_LANES] = {from.x, from.y, from.width, from.height};
+  float toLanes[TWEEN_LANES] = {to.x, to.y, to.width, to.height};
+  return startTween(TweenKind::Rect, fromLanes, toLanes, duration, easing);
+}
+
+// Redirect a tween towards a new target, starting from its current value.
+// Retargeting to the target it already has is a no-op, so immediate mode code
+// can call this every frame. A duration <= 0 keeps the track's duration.
+bool retargetTween(int handle, const float *to, float duration = 0.0f) {
+  AnimationManager &am = animationManager;
+
+  int slot = tweenSlot(handle);
+  if (slot < 0) {
+    return false;
+  }
+
+  int base = slot * TWEEN_LANES;
+  if (memcmp(&am.to[base], to, sizeof(float) * TWEEN_LANES) == 0) {
+    return true;
+  }
+
+  bool wasRunning = am.elapsed[slot] < am.duration[slot];
+  for (int lane = 0; lane < TWEEN_LANES; lane++) {
+    am.from[base + lane] = am.value[base + lane];
+    am.to[base + lane] = to[lane];
+    am.eased[base + lane] = 0.0f;
+  }
+
+  am.elapsed[slot] = 0.0f;
+  am.progress[slot] = 0.0f;
+  if (duration > 0.0f) {
+    am.duration[slot] = duration;
+  }
+
+  if (!wasRunning) {
+    am.runningTracks++;
+  }
+  return true;
+}
+
+bool retargetFloat(int handle, float to, float duration = 0.0f) {
+  float toLanes[TWEEN_LANES] = {to, 0.0f, 0.0f, 0.0f};
+  return retargetTween(handle, toLanes, duration);
+}
+
+bool retargetColor(int handle, Color to, float duration = 0.0f) {
+  float toLanes[TWEEN_LANES] = {(float)to.r, (float)to.g, (float)to.b,
+                                (float)to.a};
+  return retargetTween(handle, toLanes, duration);
+}
+
+bool retargetRect(int handle, Rectangle to, float duration = 0.0f) {
+  float toLanes[TWEEN_LANES] = {to.x, to.y, to.width, to.height};
+  return retargetTween(handle, toLanes, duration);
+}
+
+// Release a tween. Its handle becomes invalid immediately.
+void cancelTween(int handle) {
+  AnimationManager &am = animationManager;
+
+  int slot = tweenSlot(handle);
+  if (slot < 0) {
+    return;
+  }
+
+  if (am.elapsed[slot] < am.duration[slot]) {
+    am.runningTracks--;
+  }
+
+  // Park the slot at its end state so the update pass treats it as settled
+  am.elapsed[slot] = am.duration[slot];
+  am.progress[slot] = 1.0f;
+  for (int lane = 0; lane < TWEEN_LANES; lane++) {
+    int i = slot * TWEEN_LANES + lane;
+    am.from[i] = am.to[i] = am.value[i] = 0.0f;
+    am.eased[i] = 1.0f;
+  }
+
+  am.alive[slot] = 0;
+  am.freeSlots.push_back((uint16_t)slot);
+}
+
+bool isTweenValid(int handle) { return tweenSlot(handle) >= 0; }
+
+bool isTweenRunning(int handle) {
+  int slot = tweenSlot(handle);
+  return slot >= 0 &&
+         animationManager.elapsed[slot] < animationManager.duration[slot];
+}
+
+TweenKind getTweenKind(int handle) {
+  int slot = tweenSlot(handle);
+  return slot >= 0 ? animationManager.kind[slot] : TweenKind::Float;
+}
+
+// Copy the current lane values of a tween into `out` (TWEEN_LANES floats)
+bool getTweenLanes(int handle, float *out) {
+  int slot = tweenSlot(handle);
+  if (slot < 0) {
+    return false;
+  }
+  memcpy(out, &animationManager.value[slot * TWEEN_LANES],
+         sizeof(float) * TWEEN_LANES);
+  return true;
+}
+
+float getTweenFloat(int handle, float fallback = 0.0f) {
+  int slot = tweenSlot(handle);
+  return slot >= 0 ? animationManager.value[slot * TWEEN_LANES] : fallback;
+}
+
+Color getTweenColor(int handle, Color fallback = BLANK) {
+  float lanes[TWEEN_LANES];
+  if (!getTweenLanes(handle, lanes)) {
+    return fallback;
+  }
+
+  // Overshooting curves (OutBack) can leave the 0..255 range
+  Color color;
+  color.r = (unsigned char)fminf(fmaxf(roundf(lanes[0]), 0.0f), 255.0f);
+  color.g = (unsigned char)fminf(fmaxf(roundf(lanes[1]), 0.0f), 255.0f);
+  color.b = (unsigned char)fminf(fmaxf(roundf(lanes[2]), 0.0f), 255.0f);
+  color.a = (unsigned char)fminf(fmaxf(roundf(lanes[3]), 0.0f), 255.0f);
+  return color;
+}
+
+Rectangle getTweenRect(int handle, Rectangle fallback = {0, 0, 0, 0}) {
+  float lanes[TWEEN_LANES];
+  if (!getTweenLanes(handle, lanes)) {
+    return fallback;
+  }
+  return (Rectangle){lanes[0], lanes[1], lanes[2], lanes[3]};
+}
+
+// Advance every tween by `deltaTime` seconds. Runs in three flat passes so
+// the time and interpolation loops auto-vectorize; only the easing pass
+// branches per track.
+void updateAnimations(float deltaTime) {
+  AnimationManager &am = animationManager;
+
+  if (am.runningTracks == 0) {
+    return;
+  }
+
+  size_t trackCount = am.generation.size();
+  float *elapsed = am.elapsed.data();
+  const float *duration = am.duration.data();
+  float *progress = am.progress.data();
+
+  // Pass 1: advance time and normalize progress
+  for (size_t i = 0; i < trackCount; i++) {
+    elapsed[i] = fminf(elapsed[i] + deltaTime, duration[i]);
+    progress[i] = elapsed[i] / duration[i];
+  }
+
+  // Pass 2: evaluate easing curves and broadcast them to each track's lanes
+  int running = 0;
+  float *eased = am.eased.data();
+  for (size_t i = 0; i < trackCount; i++) {
+    float t = applyEasing(am.easing[i], progress[i]);
+    float *lanes = eased + i * TWEEN_LANES;
+    lanes[0] = lanes[1] = lanes[2] = lanes[3] = t;
+    running += progress[i] < 1.0f;
+  }
+
+  // Pass 3: interpolate every lane
+  size_t laneCount = trackCount * TWEEN_LANES;
+  const float *from = am.from.data();
+  const float *to = am.to.data();
+  float *value = am.value.data();
+  for (size_t i = 0; i < laneCount; i++) {
+    value[i] = from[i] + (to[i] - from[i]) * eased[i];
+  }
+
+  am.runningTracks = running;
+}
+
+// True while any tween is still moving - lets the main loop throttle idle
+// frames
+bool animationsActive() { return animationManager.runningTracks > 0; }
+
+// Release all tween storage
+void unloadAnimations() { animationManager = AnimationManager{}; }
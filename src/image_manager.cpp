@@ -0,0 +1,393 @@
+#pragma once
+#include "utils/colors.cpp"
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <mutex>
+#include <raylib.h>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Decoding runs on worker threads (pthreads, natively and on the web); GPU
+// uploads happen on the main thread in updateImages()
+const int IMAGE_WORKER_COUNT = 2;
+
+// Images whose sides are both <= ATLAS_MAX_ICON_SIZE are packed into shared
+// atlas pages so they batch with each other; anything larger gets its own
+// texture in the LRU cache
+const int ATLAS_PAGE_SIZE = 1024;
+const int ATLAS_MAX_ICON_SIZE = 128;
+const int ATLAS_PADDING = 1; // gap between packed icons to avoid bleeding
+const int ATLAS_MAX_PAGES = 4;
+
+// GPU memory allowed for standalone textures before least recently used ones
+// are evicted
+const size_t IMAGE_CACHE_BUDGET_BYTES = 64 * 1024 * 1024;
+
+// Pixel data uploaded per frame - keeps big batches of decodes from hitching.
+// At least one image is always uploaded per frame.
+const size_t IMAGE_UPLOAD_BUDGET_BYTES = 4 * 1024 * 1024;
+
+enum class ImageState : uint8_t {
+  Unloaded, // known but not decoded (never requested or evicted)
+  Loading,  // queued or decoding on a worker
+  Ready,    // on the GPU and drawable
+  Failed    // file missing or not decodable
+};
+
+struct ImageEntry {
+  std::string path;
+  ImageState state;
+  int width; // natural size in pixels, valid once decoded
+  int height;
+  int atlasPage;     // -1 = standalone texture
+  Rectangle source;  // region of the atlas page or standalone texture
+  Texture2D texture; // standalone texture only
+  size_t textureBytes;
+  bool inLru;
+  std::list<int>::iterator lruPosition;
+  unsigned int lastUsedFrame;
+};
+
+// Shelf packer state for one atlas page
+struct AtlasPage {
+  Texture2D texture;
+  int cursorX;     // next free x on the current shelf
+  int shelfY;      // top of the current shelf
+  int shelfHeight; // tallest icon on the current shelf
+};
+
+struct DecodedImage {
+  int id;
+  Image image; // data == nullptr when decoding failed
+};
+
+struct ImageManager {
+  std::vector<ImageEntry> entries;
+  std::unordered_map<std::string, int> idsByPath;
+  std::vector<AtlasPage> atlasPages;
+  std::list<int> lru; // standalone textures, most recently used first
+  size_t cacheBytes;
+  unsigned int frame;
+
+  // Decoded images waiting for upload (main thread only)
+  std::deque<DecodedImage> uploads;
+
+  // Shared with the workers, guarded by mutex
+  std::mutex mutex;
+  std::condition_variable wake;
+  std::deque<std::pair<int, std::string>> jobs;
+  std::vector<DecodedImage> decoded;
+  bool stopping;
+
+  std::vector<std::thread> workers;
+};
+
+static ImageManager imageManager;
+
+static void imageWorker() {
+  ImageManager &im = imageManager;
+
+  while (true) {
+    std::pair<int, std::string> job;
+    {
+      std::unique_lock<std::mutex> lock(im.mutex);
+      im.wake.wait(lock, [&] { return im.stopping || !im.jobs.empty(); });
+      if (im.stopping) {
+        return;
+      }
+      job = std::move(im.jobs.front());
+      im.jobs.pop_front();
+    }
+
+    DecodedImage result = {job.first, {}};
+
+    int dataSize = 0;
+    unsigned char *data = LoadFileData(job.second.c_str(), &dataSize);
+    if (data != nullptr) {
+      result.image = LoadImageFromMemory(GetFileExtension(job.second.c_str()),
+                                         data, dataSize);
+      UnloadFileData(data);
+    }
+
+    // Atlas pages are RGBA8, so normalize here rather than on the main thread
+    if (result.image.data != nullptr) {
+      ImageFormat(&result.image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+    }
+
+    std::lock_guard<std::mutex> lock(im.mutex);
+    im.decoded.push_back(result);
+  }
+}
+
+// Start the decode workers
+void initImages() {
+  ImageManager &im = imageManager;
+
+  if (!im.workers.empty()) {
+    return;
+  }
+
+  im.stopping = false;
+  for (int i = 0; i < IMAGE_WORKER_COUNT; i++) {
+    im.workers.emplace_back(imageWorker);
+  }
+}
+
+// Get the id for an image path. Does not start loading - drawing or touching
+// the image does. Hashes the path, so look ids up once rather than per frame.
+int requestImage(const char *path) {
+  ImageManager &im = imageManager;
+
+  auto found = im.idsByPath.find(path);
+  if (found != im.idsByPath.end()) {
+    return found->second;
+  }
+
+  ImageEntry entry = {};
+  entry.path = path;
+  entry.state = ImageState::Unloaded;
+  entry.atlasPage = -1;
+
+  int id = (int)im.entries.size();
+  im.entries.push_back(entry);
+  im.idsByPath.emplace(entry.path, id);
+  return id;
+}
+
+// Mark an image as used this frame, queueing it for decoding if needed
+ImageState touchImage(int id) {
+  ImageManager &im = imageManager;
+
+  if (id < 0 || id >= (int)im.entries.size()) {
+    return ImageState::Failed;
+  }
+
+  ImageEntry &entry = im.entries[id];
+  entry.lastUsedFrame = im.frame;
+
+  if (entry.state == ImageState::Unloaded) {
+    entry.state = ImageState::Loading;
+    {
+      std::lock_guard<std::mutex> lock(im.mutex);
+      im.jobs.emplace_back(id, entry.path);
+    }
+    im.wake.notify_one();
+  } else if (entry.inLru && entry.lruPosition != im.lru.begin()) {
+    im.lru.splice(im.lru.begin(), im.lru, entry.lruPosition);
+  }
+
+  return entry.state;
+}
+
+// Reserve a w x h region in an atlas page using shelf packing. Returns false
+// when every page is full.
+static bool packIntoAtlas(int width, int height, int *page, Rectangle *rect) {
+  ImageManager &im = imageManager;
+
+  int paddedWidth = width + ATLAS_PADDING;
+  int paddedHeight = height + ATLAS_PADDING;
+
+  for (size_t i = 0; i <= im.atlasPages.size(); i++) {
+    if (i == im.atlasPages.size()) {
+      if ((int)i >= ATLAS_MAX_PAGES) {
+        return false;
+      }
+
+      Image blank = GenImageColor(ATLAS_PAGE_SIZE, ATLAS_PAGE_SIZE, BLANK);
+      AtlasPage newPage = {LoadTextureFromImage(blank), 0, 0, 0};
+      UnloadImage(blank);
+      SetTextureFilter(newPage.texture, TEXTURE_FILTER_BILINEAR);
+      im.atlasPages.push_back(newPage);
+    }
+
+    AtlasPage &atlas = im.atlasPages[i];
+
+    // Start a new shelf when the current one has no room left
+    if (atlas.cursorX + paddedWidth > ATLAS_PAGE_SIZE) {
+      atlas.shelfY += atlas.shelfHeight;
+      atlas.cursorX = 0;
+      atlas.shelfHeight = 0;
+    }
+    if (atlas.shelfY + paddedHeight > ATLAS_PAGE_SIZE) {
+      continue;
+    }
+
+    *page = (int)i;
+    *rect = (Rectangle){(float)atlas.cursorX, (float)atlas.shelfY,
+                        (float)width, (float)height};
+    atlas.cursorX += paddedWidth;
+    if (paddedHeight > atlas.shelfHeight) {
+      atlas.shelfHeight = paddedHeight;
+    }
+    return true;
+  }
+
+  return false;
+}
+
+// Unload least recently used standalone textures until within budget. Images
+// drawn in the previous frame are never evicted, so a working set larger than
+// the budget degrades to going over budget rather than reloading every frame.
+static void evictImages() {
+  ImageManager &im = imageManager;
+
+  while (im.cacheBytes > IMAGE_CACHE_BUDGET_BYTES && !im.lru.empty()) {
+    ImageEntry &entry = im.entries[im.lru.back()];
+    if (entry.lastUsedFrame + 1 >= im.frame) {
+      break;
+    }
+
+    UnloadTexture(entry.texture);
+    entry.texture = {};
+    entry.state = ImageState::Unloaded;
+    entry.inLru = false;
+    im.cacheBytes -= entry.textureBytes;
+    entry.textureBytes = 0;
+    im.lru.pop_back();
+  }
+}
+
+static void uploadImage(DecodedImage &decoded) {
+  ImageManager &im = imageManager;
+  ImageEntry &entry = im.entries[decoded.id];
+
+  if (decoded.image.data == nullptr) {
+    entry.state = ImageState::Failed;
+    return;
+  }
+
+  entry.width = decoded.image.width;
+  entry.height = decoded.image.height;
+
+  // Icons that were packed before keep their atlas slot after a reload
+  bool small = entry.width <= ATLAS_MAX_ICON_SIZE &&
+               entry.height <= ATLAS_MAX_ICON_SIZE;
+  if (small && (entry.atlasPage >= 0 ||
+                packIntoAtlas(entry.width, entry.height, &entry.atlasPage,
+                              &entry.source))) {
+    UpdateTextureRec(im.atlasPages[entry.atlasPage].texture, entry.source,
+                     decoded.image.data);
+  } else {
+    entry.atlasPage = -1;
+    entry.texture = LoadTextureFromImage(decoded.image);
+    SetTextureFilter(entry.texture, TEXTURE_FILTER_BILINEAR);
+    entry.source = (Rectangle){0, 0, (float)entry.width, (float)entry.height};
+    entry.textureBytes = (size_t)entry.width * entry.height * 4;
+
+    im.cacheBytes += entry.textureBytes;
+    im.lru.push_front(decoded.id);
+    entry.lruPosition = im.lru.begin();
+    entry.inLru = true;
+  }
+
+  UnloadImage(decoded.image);
+  entry.state = ImageState::Ready;
+}
+
+// Upload finished decodes within the per-frame budget and enforce the cache
+// budget. Call once per frame on the main thread.
+void updateImages() {
+  ImageManager &im = imageManager;
+
+  im.frame++;
+
+  {
+    std::lock_guard<std::mutex> lock(im.mutex);
+    for (DecodedImage &decoded : im.decoded) {
+      im.uploads.push_back(decoded);
+    }
+    im.decoded.clear();
+  }
+
+  size_t uploadedBytes = 0;
+  while (!im.uploads.empty() && uploadedBytes < IMAGE_UPLOAD_BUDGET_BYTES) {
+    DecodedImage decoded = im.uploads.front();
+    im.uploads.pop_front();
+
+    uploadedBytes += (size_t)decoded.image.width * decoded.image.height * 4;
+    uploadImage(decoded);
+  }
+
+  evictImages();
+}
+
+// Natural pixel size of an image (0x0 until it has been decoded)
+Vector2 getImageSize(int id) {
+  if (id < 0 || id >= (int)imageManager.entries.size()) {
+    return (Vector2){0, 0};
+  }
+  const ImageEntry &entry = imageManager.entries[id];
+  return (Vector2){(float)entry.width, (float)entry.height};
+}
+
+// Draw an image into a logical rectangle. Shows a placeholder until the image
+// is ready, so drawing never waits on decoding.
+ImageState drawImage(int id, Rectangle dest, Color tint = WHITE) {
+  ImageState state = touchImage(id);
+
+  // Convert logical coordinates to physical coordinates
+  float scale = getScaleFactor();
+  Rectangle physicalDest = scaleRectRound(dest, scale);
+
+  if (state != ImageState::Ready) {
+    DrawRectangleRec(physicalDest, Colors::Gray::Gray800);
+    if (state == ImageState::Failed) {
+      DrawRectangleLinesEx(physicalDest, fmaxf(1.0f, roundf(scale)),
+                           Colors::Status::Error);
+    }
+    return state;
+  }
+
+  const ImageEntry &entry = imageManager.entries[id];
+  Texture2D texture = entry.atlasPage >= 0
+                          ? imageManager.atlasPages[entry.atlasPage].texture
+                          : entry.texture;
+  DrawTexturePro(texture, entry.source, physicalDest, (Vector2){0, 0}, 0.0f,
+                 tint);
+  return state;
+}
+
+// Stop the workers and release every texture
+void unloadImages() {
+  ImageManager &im = imageManager;
+
+  {
+    std::lock_guard<std::mutex> lock(im.mutex);
+    im.stopping = true;
+    im.jobs.clear();
+  }
+  im.wake.notify_all();
+  for (std::thread &worker : im.workers) {
+    worker.join();
+  }
+  im.workers.clear();
+
+  for (DecodedImage &decoded : im.decoded) {
+    UnloadImage(decoded.image);
+  }
+  for (DecodedImage &decoded : im.uploads) {
+    UnloadImage(decoded.image);
+  }
+  im.decoded.clear();
+  im.uploads.clear();
+
+  for (ImageEntry &entry : im.entries) {
+    if (entry.inLru) {
+      UnloadTexture(entry.texture);
+    }
+  }
+  for (AtlasPage &page : im.atlasPages) {
+    UnloadTexture(page.texture);
+  }
+
+  im.entries.clear();
+  im.idsByPath.clear();
+  im.atlasPages.clear();
+  im.lru.clear();
+  im.cacheBytes = 0;
+}
@@ -5,6 +5,9 @@
 #include <lauxlib.h>
 #include <lualib.h>
 #include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
 
 // Global Lua state
 lua_State* L = nullptr;
@@ -44,43 +47,28 @@ static int lua_button(lua_State* L) {
     btn.text = lua_tostring(L, -1);
     lua_pop(L, 1);
     
-    // Get optional fields with defaults
-    lua_getfield(L, 1, "fontSize");
-    btn.fontSize = lua_isnumber(L, -1) ? lua_tonumber(L, -1) : 56;
-    lua_pop(L, 1);
-    
-    lua_getfield(L, 1, "borderWidth");
-    btn.borderWidth = lua_isnumber(L, -1) ? lua_tonumber(L, -1) : 2.0f;
+    // Style handle from style()/getStyle() - colors, metrics and font all
+    // come precompiled from the active theme. Register a style for a
+    // different look rather than overriding it per call.
+    lua_getfield(L, 1, "style");
+    int styleHandle = lua_isnumber(L, -1) ? lua_tointeger(L, -1) : STYLE_DEFAULT;
     lua_pop(L, 1);
     
-    lua_getfield(L, 1, "borderRadius");
-    btn.borderRadius = lua_isnumber(L, -1) ? lua_tonumber(L, -1) : 0.3f;
-    lua_pop(L, 1);
+    const Style* style = getStyle(styleHandle);
+    if (style == nullptr) {
+        style = getStyle(STYLE_DEFAULT);
+    }
+    applyButtonStyle(&btn, style);
     
-    lua_getfield(L, 1, "segments");
-    btn.segments = lua_isnumber(L, -1) ? lua_tonumber(L, -1) : 16;
+    // Optional color tweens (from tween()) for animated state transitions
+    lua_getfield(L, 1, "backgroundTween");
+    btn.backgroundTween = lua_isnumber(L, -1) ? lua_tointeger(L, -1) : 0;
     lua_pop(L, 1);
     
-    // Check if useRoboto is specified
-    lua_getfield(L, 1, "useRoboto");
-    bool useRoboto = lua_isboolean(L, -1) ? lua_toboolean(L, -1) : true; // Default to true
+    lua_getfield(L, 1, "borderTween");
+    btn.borderTween = lua_isnumber(L, -1) ? lua_tointeger(L, -1) : 0;
     lua_pop(L, 1);
     
-    // Set colors using the same colors as the original C++ button
-    btn.backgroundColor = (Color){74, 144, 226, 255};   // Colors::Button::Default equivalent
-    btn.textColor = (Color){255, 255, 255, 255};        // Colors::Text::OnDark equivalent  
-    btn.hoverColor = (Color){94, 164, 246, 255};        // Colors::Button::DefaultHover equivalent
-    btn.pressedColor = (Color){54, 124, 206, 255};      // Colors::Button::DefaultPressed equivalent
-    btn.borderColor = (Color){100, 100, 100, 255};     // Colors::Border::Default equivalent
-    
-    // Set font - use roboto if requested
-    if (useRoboto) {
-        static Font roboto = getRobotoRegular(); // Store font statically
-        btn.font = &roboto;
-    } else {
-        btn.font = nullptr;
-    }
-    
     // Call the C++ button function
     ButtonState state = button(&btn);
     
@@ -99,6 +87,644 @@ static int lua_button(lua_State* L) {
     return 1; // Return the state table
 }
 
+// Read a tween value (number, {r,g,b,a} color or {x,y,width,height} rect) at
+// the given stack index into TWEEN_LANES floats
+static TweenKind readTweenLanes(lua_State* L, int index, float* lanes) {
+    lanes[0] = lanes[1] = lanes[2] = lanes[3] = 0.0f;
+    
+    if (lua_isnumber(L, index)) {
+        lanes[0] = lua_tonumber(L, index);
+        return TweenKind::Float;
+    }
+    
+    if (!lua_istable(L, index)) {
+        luaL_error(L, "Expected number, color or rect table as tween value");
+        return TweenKind::Float;
+    }
+    
+    lua_getfield(L, index, "r");
+    bool isColor = !lua_isnil(L, -1);
+    lua_pop(L, 1);
+    
+    static const char* colorFields[TWEEN_LANES] = {"r", "g", "b", "a"};
+    static const char* rectFields[TWEEN_LANES] = {"x", "y", "width", "height"};
+    const char** fields = isColor ? colorFields : rectFields;
+    
+    for (int lane = 0; lane < TWEEN_LANES; lane++) {
+        lua_getfield(L, index, fields[lane]);
+        // Alpha defaults to opaque when omitted
+        lanes[lane] = lua_isnumber(L, -1) ? lua_tonumber(L, -1)
+                      : (isColor && lane == 3) ? 255.0f : 0.0f;
+        lua_pop(L, 1);
+    }
+    
+    return isColor ? TweenKind::Color : TweenKind::Rect;
+}
+
+// tween{from=..., to=..., duration=0.2, easing="outCubic"} -> handle
+static int lua_tween(lua_State* L) {
+    if (!lua_istable(L, 1)) {
+        luaL_error(L, "Expected table as first argument to tween()");
+        return 0;
+    }
+    
+    float from[TWEEN_LANES];
+    float to[TWEEN_LANES];
+    
+    lua_getfield(L, 1, "from");
+    TweenKind kind = readTweenLanes(L, -1, from);
+    lua_pop(L, 1);
+    
+    // A missing target starts the tween settled at its initial value
+    lua_getfield(L, 1, "to");
+    if (lua_isnil(L, -1)) {
+        memcpy(to, from, sizeof(from));
+    } else if (readTweenLanes(L, -1, to) != kind) {
+        luaL_error(L, "tween() 'from' and 'to' must be the same kind of value");
+    }
+    lua_pop(L, 1);
+    
+    lua_getfield(L, 1, "duration");
+    float duration = lua_isnumber(L, -1) ? lua_tonumber(L, -1) : 0.2f;
+    lua_pop(L, 1);
+    
+    lua_getfield(L, 1, "easing");
+    Easing easing = easingFromName(lua_tostring(L, -1));
+    lua_pop(L, 1);
+    
+    lua_pushinteger(L, startTween(kind, from, to, duration, easing));
+    return 1;
+}
+
+// retarget(handle, to [, duration]) -> boolean
+static int lua_retarget(lua_State* L) {
+    int handle = luaL_checkinteger(L, 1);
+    
+    float to[TWEEN_LANES];
+    if (readTweenLanes(L, 2, to) != getTweenKind(handle) && isTweenValid(handle)) {
+        luaL_error(L, "retarget() value does not match the tween's kind");
+    }
+    
+    lua_pushboolean(L, retargetTween(handle, to, luaL_optnumber(L, 3, 0.0)));
+    return 1;
+}
+
+// cancelTween(handle)
+static int lua_cancelTween(lua_State* L) {
+    cancelTween(luaL_checkinteger(L, 1));
+    return 0;
+}
+
+// tweenValue(handle) -> number, color table or rect table (nil if invalid)
+static int lua_tweenValue(lua_State* L) {
+    int handle = luaL_checkinteger(L, 1);
+    
+    float lanes[TWEEN_LANES];
+    if (!getTweenLanes(handle, lanes)) {
+        lua_pushnil(L);
+        return 1;
+    }
+    
+    switch (getTweenKind(handle)) {
+        case TweenKind::Float:
+            lua_pushnumber(L, lanes[0]);
+            break;
+        case TweenKind::Color: {
+            Color color = getTweenColor(handle);
+            lua_newtable(L);
+            lua_pushinteger(L, color.r);
+            lua_setfield(L, -2, "r");
+            lua_pushinteger(L, color.g);
+            lua_setfield(L, -2, "g");
+            lua_pushinteger(L, color.b);
+            lua_setfield(L, -2, "b");
+            lua_pushinteger(L, color.a);
+            lua_setfield(L, -2, "a");
+            break;
+        }
+        case TweenKind::Rect:
+            lua_newtable(L);
+            lua_pushnumber(L, lanes[0]);
+            lua_setfield(L, -2, "x");
+            lua_pushnumber(L, lanes[1]);
+            lua_setfield(L, -2, "y");
+            lua_pushnumber(L, lanes[2]);
+            lua_setfield(L, -2, "width");
+            lua_pushnumber(L, lanes[3]);
+            lua_setfield(L, -2, "height");
+            break;
+    }
+    return 1;
+}
+
+// tweenRunning(handle) -> boolean
+static int lua_tweenRunning(lua_State* L) {
+    lua_pushboolean(L, isTweenRunning(luaL_checkinteger(L, 1)));
+    return 1;
+}
+
+// Read a {r=, g=, b=, a=} color field of the table at `index`. A missing
+// field gives `fallback`; anything other than a color table is an error.
+// Channels are clamped to 0..255 and alpha defaults to opaque.
+static Color readColorField(lua_State* L, int index, const char* field, Color fallback) {
+    lua_getfield(L, index, field);
+    if (lua_isnil(L, -1)) {
+        lua_pop(L, 1);
+        return fallback;
+    }
+    
+    bool isColor = false;
+    if (lua_istable(L, -1)) {
+        lua_getfield(L, -1, "r");
+        isColor = !lua_isnil(L, -1);
+        lua_pop(L, 1);
+    }
+    if (!isColor) {
+        luaL_error(L, "'%s' must be a {r=, g=, b=, a=} color table", field);
+    }
+    
+    float lanes[TWEEN_LANES];
+    readTweenLanes(L, lua_gettop(L), lanes);
+    lua_pop(L, 1);
+    
+    Color color;
+    color.r = (unsigned char)fminf(fmaxf(roundf(lanes[0]), 0.0f), 255.0f);
+    color.g = (unsigned char)fminf(fmaxf(roundf(lanes[1]), 0.0f), 255.0f);
+    color.b = (unsigned char)fminf(fmaxf(roundf(lanes[2]), 0.0f), 255.0f);
+    color.a = (unsigned char)fminf(fmaxf(roundf(lanes[3]), 0.0f), 255.0f);
+    return color;
+}
+
+static void pushColor(lua_State* L, Color color) {
+    lua_createtable(L, 0, 4);
+    lua_pushinteger(L, color.r);
+    lua_setfield(L, -2, "r");
+    lua_pushinteger(L, color.g);
+    lua_setfield(L, -2, "g");
+    lua_pushinteger(L, color.b);
+    lua_setfield(L, -2, "b");
+    lua_pushinteger(L, color.a);
+    lua_setfield(L, -2, "a");
+}
+
+// loadImage(path) -> image handle. Paths are looked up once here; image{}
+// takes the handle so drawing never hashes a path.
+static int lua_loadImage(lua_State* L) {
+    lua_pushinteger(L, requestImage(luaL_checkstring(L, 1)));
+    return 1;
+}
+
+// Lua binding for image drawing:
+// image{id=handle, x=0, y=0, width=64, height=64} -> {ready, failed, width, height}
+// width/height default to the image's natural size once it is decoded
+
+static int lua_image(lua_State* L) {
+    if (!lua_istable(L, 1)) {
+        luaL_error(L, "Expected table as first argument to image()");
+        return 0;
+    }
+    
+    lua_getfield(L, 1, "id");
+    if (!lua_isinteger(L, -1)) {
+        luaL_error(L, "image() requires an 'id' from loadImage()");
+    }
+    int id = (int)lua_tointeger(L, -1);
+    lua_pop(L, 1);
+    
+    Vector2 naturalSize = getImageSize(id);
+    Rectangle dest;
+    
+    lua_getfield(L, 1, "x");
+    dest.x = lua_tonumber(L, -1);
+    lua_pop(L, 1);
+    
+    lua_getfield(L, 1, "y");
+    dest.y = lua_tonumber(L, -1);
+    lua_pop(L, 1);
+    
+    lua_getfield(L, 1, "width");
+    dest.width = lua_isnumber(L, -1) ? lua_tonumber(L, -1) : naturalSize.x;
+    lua_pop(L, 1);
+    
+    lua_getfield(L, 1, "height");
+    dest.height = lua_isnumber(L, -1) ? lua_tonumber(L, -1) : naturalSize.y;
+    lua_pop(L, 1);
+    
+    ImageState state = drawImage(id, dest);
+    naturalSize = getImageSize(id);
+    
+    // Return image state as a table
+    lua_newtable(L);
+    
+    lua_pushboolean(L, state == ImageState::Ready);
+    lua_setfield(L, -2, "ready");
+    
+    lua_pushboolean(L, state == ImageState::Failed);
+    lua_setfield(L, -2, "failed");
+    
+    lua_pushnumber(L, naturalSize.x);
+    lua_setfield(L, -2, "width");
+    
+    lua_pushnumber(L, naturalSize.y);
+    lua_setfield(L, -2, "height");
+    
+    return 1;
+}
+
+// Text documents created from Lua, addressed by 1-based handle
+static std::vector<TextDocument> luaDocuments;
+
+static TextDocument* checkDocument(lua_State* L, int index) {
+    lua_Integer handle = luaL_checkinteger(L, index);
+    if (handle < 1 || handle > (lua_Integer)luaDocuments.size()) {
+        luaL_error(L, "Invalid text document handle");
+        return nullptr;
+    }
+    return &luaDocuments[handle - 1];
+}
+
+// textDocument{fontSize=28, lineHeight=1.3, align="left", wrap=true, maxLines=0, bold=false} -> handle
+static int lua_textDocument(lua_State* L) {
+    TextDocument doc = {};
+    doc.style = {getRobotoRegular(), 28.0f, 1.3f, TextAlign::Left, true, 0};
+    
+    if (lua_istable(L, 1)) {
+        lua_getfield(L, 1, "fontSize");
+        if (lua_isnumber(L, -1)) doc.style.fontSize = lua_tonumber(L, -1);
+        lua_pop(L, 1);
+        
+        lua_getfield(L, 1, "lineHeight");
+        if (lua_isnumber(L, -1)) doc.style.lineHeight = lua_tonumber(L, -1);
+        lua_pop(L, 1);
+        
+        lua_getfield(L, 1, "align");
+        const char* align = lua_tostring(L, -1);
+        if (align != nullptr && strcmp(align, "center") == 0) {
+            doc.style.align = TextAlign::Center;
+        } else if (align != nullptr && strcmp(align, "right") == 0) {
+            doc.style.align = TextAlign::Right;
+        }
+        lua_pop(L, 1);
+        
+        lua_getfield(L, 1, "wrap");
+        if (lua_isboolean(L, -1)) doc.style.wrap = lua_toboolean(L, -1);
+        lua_pop(L, 1);
+        
+        lua_getfield(L, 1, "maxLines");
+        if (lua_isnumber(L, -1)) doc.style.maxLines = lua_tointeger(L, -1);
+        lua_pop(L, 1);
+        
+        lua_getfield(L, 1, "bold");
+        if (lua_toboolean(L, -1)) doc.style.font = getRobotoBold();
+        lua_pop(L, 1);
+    }
+    
+    luaDocuments.push_back(doc);
+    lua_pushinteger(L, (lua_Integer)luaDocuments.size());
+    return 1;
+}
+
+// textSet(doc, text)
+static int lua_textSet(lua_State* L) {
+    setDocumentText(checkDocument(L, 1), luaL_checkstring(L, 2));
+    return 0;
+}
+
+// textAppend(doc, text)
+static int lua_textAppend(lua_State* L) {
+    appendDocumentText(checkDocument(L, 1), luaL_checkstring(L, 2));
+    return 0;
+}
+
+// textInsert(doc, paragraph, byteOffset, text) - paragraph and offset are 1-based
+static int lua_textInsert(lua_State* L) {
+    TextDocument* doc = checkDocument(L, 1);
+    insertDocumentText(doc, luaL_checkinteger(L, 2) - 1, luaL_checkinteger(L, 3) - 1,
+                       luaL_checkstring(L, 4));
+    return 0;
+}
+
+// textErase(doc, paragraph, byteOffset, length) - paragraph and offset are 1-based.
+// A paragraph break counts as one byte, so erasing past the end of a
+// paragraph joins the next one onto it.
+static int lua_textErase(lua_State* L) {
+    TextDocument* doc = checkDocument(L, 1);
+    eraseDocumentText(doc, luaL_checkinteger(L, 2) - 1, luaL_checkinteger(L, 3) - 1,
+                      luaL_checkinteger(L, 4));
+    return 0;
+}
+
+// textDraw(doc, {x=, y=, width=, height=, scrollY=0, color=WHITE}) -> content height in logical pixels
+static int lua_textDraw(lua_State* L) {
+    TextDocument* doc = checkDocument(L, 1);
+    luaL_checktype(L, 2, LUA_TTABLE);
+    
+    Rectangle bounds;
+    
+    lua_getfield(L, 2, "x");
+    bounds.x = lua_tonumber(L, -1);
+    lua_pop(L, 1);
+    
+    lua_getfield(L, 2, "y");
+    bounds.y = lua_tonumber(L, -1);
+    lua_pop(L, 1);
+    
+    lua_getfield(L, 2, "width");
+    bounds.width = lua_tonumber(L, -1);
+    lua_pop(L, 1);
+    
+    lua_getfield(L, 2, "height");
+    bounds.height = lua_tonumber(L, -1);
+    lua_pop(L, 1);
+    
+    lua_getfield(L, 2, "scrollY");
+    float scrollY = lua_tonumber(L, -1);
+    lua_pop(L, 1);
+    
+    Color color = readColorField(L, 2, "color", WHITE);
+    
+    drawDocument(doc, bounds, scrollY, color);
+    
+    lua_pushnumber(L, getDocumentHeight(doc) / getScaleFactor());
+    return 1;
+}
+
+// style{name="card", theme="dark", background=..., hover=..., pressed=...,
+//       text=..., border=..., borderWidth=2, borderRadius=0.3, segments=16,
+//       fontSize=56, bold=false} -> handle
+// Unset fields come from the "default" style; hover/pressed default to a
+// lighter/darker background.
+static int lua_style(lua_State* L) {
+    luaL_checktype(L, 1, LUA_TTABLE);
+    
+    lua_getfield(L, 1, "name");
+    if (!lua_isstring(L, -1)) {
+        luaL_error(L, "style() requires a 'name' string");
+    }
+    std::string name = lua_tostring(L, -1);
+    lua_pop(L, 1);
+    
+    lua_getfield(L, 1, "theme");
+    int theme = lua_isstring(L, -1) ? registerTheme(lua_tostring(L, -1)) : 0;
+    lua_pop(L, 1);
+    
+    const Style* base = getStyle(STYLE_DEFAULT);
+    StyleDesc desc = {};
+    desc.background = readColorField(L, 1, "background", base->background[STYLE_NORMAL]);
+    desc.hover = readColorField(L, 1, "hover", adjustColor(desc.background, 1.15f));
+    desc.pressed = readColorField(L, 1, "pressed", adjustColor(desc.background, 0.85f));
+    desc.text = readColorField(L, 1, "text", base->text);
+    desc.border = readColorField(L, 1, "border", base->border[STYLE_NORMAL]);
+    
+    lua_getfield(L, 1, "borderWidth");
+    desc.borderWidth = lua_isnumber(L, -1) ? lua_tonumber(L, -1) : base->borderWidth;
+    lua_pop(L, 1);
+    
+    lua_getfield(L, 1, "borderRadius");
+    desc.borderRadius = lua_isnumber(L, -1) ? lua_tonumber(L, -1) : base->borderRadius;
+    lua_pop(L, 1);
+    
+    lua_getfield(L, 1, "segments");
+    desc.segments = lua_isnumber(L, -1) ? lua_tointeger(L, -1) : base->segments;
+    lua_pop(L, 1);
+    
+    lua_getfield(L, 1, "fontSize");
+    desc.fontSize = lua_isnumber(L, -1) ? lua_tointeger(L, -1) : base->fontSize;
+    lua_pop(L, 1);
+    
+    lua_getfield(L, 1, "bold");
+    desc.font = lua_toboolean(L, -1) ? getRobotoBold() : base->font;
+    lua_pop(L, 1);
+    
+    lua_pushinteger(L, registerStyle(theme, name.c_str(), desc));
+    return 1;
+}
+
+// getStyle(name) -> handle (nil if unknown)
+static int lua_getStyle(lua_State* L) {
+    int handle = findStyle(luaL_checkstring(L, 1));
+    if (handle == STYLE_NONE) {
+        lua_pushnil(L);
+    } else {
+        lua_pushinteger(L, handle);
+    }
+    return 1;
+}
+
+// theme(name) - create a theme starting from the default theme's styles
+static int lua_theme(lua_State* L) {
+    registerTheme(luaL_checkstring(L, 1));
+    return 0;
+}
+
+// setTheme(name) -> boolean
+static int lua_setTheme(lua_State* L) {
+    lua_pushboolean(L, setActiveTheme(findTheme(luaL_checkstring(L, 1))));
+    return 1;
+}
+
+// Expose the Colors palette as a read-only-by-convention `colors` global,
+// e.g. colors.button.success or colors.gray.gray300
+static void registerColorPalette(lua_State* L) {
+    static const struct {
+        const char* group;
+        const char* name;
+        Color color;
+    } palette[] = {
+        {"primary", "steel", Colors::Primary::Steel},
+        {"primary", "steelLight", Colors::Primary::SteelLight},
+        {"primary", "steelDark", Colors::Primary::SteelDark},
+        {"primary", "white", Colors::Primary::White},
+        {"primary", "black", Colors::Primary::Black},
+        {"button", "default", Colors::Button::Default},
+        {"button", "defaultHover", Colors::Button::DefaultHover},
+        {"button", "defaultPressed", Colors::Button::DefaultPressed},
+        {"button", "success", Colors::Button::Success},
+        {"button", "successHover", Colors::Button::SuccessHover},
+        {"button", "successPressed", Colors::Button::SuccessPressed},
+        {"button", "warning", Colors::Button::Warning},
+        {"button", "warningHover", Colors::Button::WarningHover},
+        {"button", "warningPressed", Colors::Button::WarningPressed},
+        {"button", "danger", Colors::Button::Danger},
+        {"button", "dangerHover", Colors::Button::DangerHover},
+        {"button", "dangerPressed", Colors::Button::DangerPressed},
+        {"text", "primary", Colors::Text::Primary},
+        {"text", "secondary", Colors::Text::Secondary},
+        {"text", "light", Colors::Text::Light},
+        {"text", "onDark", Colors::Text::OnDark},
+        {"text", "link", Colors::Text::Link},
+        {"background", "light", Colors::Background::Light},
+        {"background", "medium", Colors::Background::Medium},
+        {"background", "dark", Colors::Background::Dark},
+        {"background", "surface", Colors::Background::Surface},
+        {"background", "overlay", Colors::Background::Overlay},
+        {"status", "success", Colors::Status::Success},
+        {"status", "warning", Colors::Status::Warning},
+        {"status", "error", Colors::Status::Error},
+        {"status", "info", Colors::Status::Info},
+        {"gray", "gray50", Colors::Gray::Gray50},
+        {"gray", "gray100", Colors::Gray::Gray100},
+        {"gray", "gray200", Colors::Gray::Gray200},
+        {"gray", "gray300", Colors::Gray::Gray300},
+        {"gray", "gray400", Colors::Gray::Gray400},
+        {"gray", "gray500", Colors::Gray::Gray500},
+        {"gray", "gray600", Colors::Gray::Gray600},
+        {"gray", "gray700", Colors::Gray::Gray700},
+        {"gray", "gray800", Colors::Gray::Gray800},
+        {"gray", "gray900", Colors::Gray::Gray900},
+        {"border", "default", Colors::Border::Default},
+        {"border", "success", Colors::Border::Success},
+        {"border", "warning", Colors::Border::Warning},
+        {"border", "danger", Colors::Border::Danger},
+        {"border", "light", Colors::Border::Light},
+        {"border", "medium", Colors::Border::Medium},
+        {"border", "dark", Colors::Border::Dark},
+    };
+    
+    lua_newtable(L);
+    for (const auto& entry : palette) {
+        if (lua_getfield(L, -1, entry.group) != LUA_TTABLE) {
+            lua_pop(L, 1);
+            lua_newtable(L);
+            lua_pushvalue(L, -1);
+            lua_setfield(L, -3, entry.group);
+        }
+        pushColor(L, entry.color);
+        lua_setfield(L, -2, entry.name);
+        lua_pop(L, 1);
+    }
+    lua_setglobal(L, "colors");
+}
+
+// Charts created from Lua, addressed by 1-based handle
+static std::vector<Chart> luaCharts;
+
+static Chart* checkChart(lua_State* L, int index) {
+    lua_Integer handle = luaL_checkinteger(L, index);
+    if (handle < 1 || handle > (lua_Integer)luaCharts.size()) {
+        luaL_error(L, "Invalid chart handle");
+        return nullptr;
+    }
+    return &luaCharts[handle - 1];
+}
+
+// chart{samples=1000, autoScale=true, min=0, max=1} -> handle
+static int lua_chart(lua_State* L) {
+    Chart chart = makeChart();
+    
+    if (lua_istable(L, 1)) {
+        lua_getfield(L, 1, "samples");
+        if (lua_isnumber(L, -1)) chart.viewSamples = fmax(lua_tonumber(L, -1), 2.0);
+        lua_pop(L, 1);
+        
+        lua_getfield(L, 1, "autoScale");
+        if (lua_isboolean(L, -1)) chart.autoScale = lua_toboolean(L, -1);
+        lua_pop(L, 1);
+        
+        lua_getfield(L, 1, "min");
+        if (lua_isnumber(L, -1)) chart.minValue = lua_tonumber(L, -1);
+        lua_pop(L, 1);
+        
+        lua_getfield(L, 1, "max");
+        if (lua_isnumber(L, -1)) chart.maxValue = lua_tonumber(L, -1);
+        lua_pop(L, 1);
+        
+        chart.background = readColorField(L, 1, "background", chart.background);
+    }
+    
+    luaCharts.push_back(std::move(chart));
+    lua_pushinteger(L, (lua_Integer)luaCharts.size());
+    return 1;
+}
+
+// chartSeries(chart, {capacity=1048576, color={r,g,b,a}}) -> 1-based series index
+static int lua_chartSeries(lua_State* L) {
+    Chart* chart = checkChart(L, 1);
+    
+    size_t capacity = CHART_DEFAULT_CAPACITY;
+    Color color = Colors::Status::Info;
+    if (lua_istable(L, 2)) {
+        lua_getfield(L, 2, "capacity");
+        if (lua_isnumber(L, -1)) capacity = (size_t)fmax(lua_tonumber(L, -1), 4.0);
+        lua_pop(L, 1);
+        
+        color = readColorField(L, 2, "color", color);
+    }
+    
+    lua_pushinteger(L, addChartSeries(chart, capacity, color) + 1);
+    return 1;
+}
+
+// chartPush(chart, series, value) or chartPush(chart, series, {v1, v2, ...})
+static int lua_chartPush(lua_State* L) {
+    Chart* chart = checkChart(L, 1);
+    lua_Integer series = luaL_checkinteger(L, 2) - 1;
+    if (series < 0 || series >= (lua_Integer)chart->series.size()) {
+        luaL_error(L, "Invalid chart series");
+        return 0;
+    }
+    
+    if (lua_isnumber(L, 3)) {
+        float value = lua_tonumber(L, 3);
+        appendChartSamples(chart, (int)series, &value, 1);
+        return 0;
+    }
+    
+    luaL_checktype(L, 3, LUA_TTABLE);
+    static std::vector<float> values;
+    size_t count = lua_rawlen(L, 3);
+    values.resize(count);
+    for (size_t i = 0; i < count; i++) {
+        lua_rawgeti(L, 3, i + 1);
+        values[i] = lua_tonumber(L, -1);
+        lua_pop(L, 1);
+    }
+    appendChartSamples(chart, (int)series, values.data(), count);
+    return 0;
+}
+
+// chartView(chart, start, samples) - fixed view; chartView(chart) - follow newest data
+static int lua_chartView(lua_State* L) {
+    Chart* chart = checkChart(L, 1);
+    if (lua_isnoneornil(L, 2)) {
+        followChart(chart, luaL_optnumber(L, 3, chart->viewSamples));
+    } else {
+        setChartView(chart, luaL_checknumber(L, 2), luaL_optnumber(L, 3, chart->viewSamples));
+    }
+    return 0;
+}
+
+// chartDraw(chart, {x=, y=, width=, height=, interactive=true})
+static int lua_chartDraw(lua_State* L) {
+    Chart* chart = checkChart(L, 1);
+    luaL_checktype(L, 2, LUA_TTABLE);
+    
+    Rectangle bounds;
+    
+    lua_getfield(L, 2, "x");
+    bounds.x = lua_tonumber(L, -1);
+    lua_pop(L, 1);
+    
+    lua_getfield(L, 2, "y");
+    bounds.y = lua_tonumber(L, -1);
+    lua_pop(L, 1);
+    
+    lua_getfield(L, 2, "width");
+    bounds.width = lua_tonumber(L, -1);
+    lua_pop(L, 1);
+    
+    lua_getfield(L, 2, "height");
+    bounds.height = lua_tonumber(L, -1);
+    lua_pop(L, 1);
+    
+    lua_getfield(L, 2, "interactive");
+    bool interactive = lua_isboolean(L, -1) ? lua_toboolean(L, -1) : true;
+    lua_pop(L, 1);
+    
+    drawChart(chart, bounds, interactive);
+    return 0;
+}
+
 // Initialize Lua
 void initLua() {
     L = luaL_newstate();
@@ -106,6 +732,33 @@ void initLua() {
     
     // Register our C++ functions with Lua
     lua_register(L, "button", lua_button);
+    lua_register(L, "tween", lua_tween);
+    lua_register(L, "retarget", lua_retarget);
+    lua_register(L, "cancelTween", lua_cancelTween);
+    lua_register(L, "tweenValue", lua_tweenValue);
+    lua_register(L, "tweenRunning", lua_tweenRunning);
+    lua_register(L, "loadImage", lua_loadImage);
+    lua_register(L, "image", lua_image);
+    lua_register(L, "textDocument", lua_textDocument);
+    lua_register(L, "textSet", lua_textSet);
+    lua_register(L, "textAppend", lua_textAppend);
+    lua_register(L, "textInsert", lua_textInsert);
+    lua_register(L, "textErase", lua_textErase);
+    lua_register(L, "textDraw", lua_textDraw);
+    
+    lua_register(L, "style", lua_style);
+    lua_register(L, "getStyle", lua_getStyle);
+    lua_register(L, "theme", lua_theme);
+    lua_register(L, "setTheme", lua_setTheme);
+    registerColorPalette(L);
+    lua_register(L, "chart", lua_chart);
+    lua_register(L, "chartSeries", lua_chartSeries);
+    lua_register(L, "chartPush", lua_chartPush);
+    lua_register(L, "chartView", lua_chartView);
+    lua_register(L, "chartDraw", lua_chartDraw);
+    
+    // spawn/yield/sleep/await/signal for background tasks
+    registerTaskScheduler(L);
     
     // Test Lua is working
     const char* test_script = R"(
@@ -117,7 +770,22 @@ void initLua() {
             return a * b
         end
         
-        -- Example button function with roboto font and centered positioning
+        -- Color tweens the button eases through on hover/press
+        local buttonBackground = tween({
+            from = {r = 74, g = 144, b = 226, a = 255},
+            duration = 0.15,
+            easing = "outCubic"
+        })
+        local buttonBorder = tween({
+            from = {r = 100, g = 100, b = 100, a = 255},
+            duration = 0.15,
+            easing = "outCubic"
+        })
+        
+        -- Style handles are looked up once; the button only passes the integer
+        local buttonStyle = getStyle("default")
+        
+        -- Example button function with centered positioning
         function drawTestButton()
             -- Center the button on the reference 1920x1080 design
             local btnWidth = 300
@@ -131,11 +799,9 @@ void initLua() {
                 width = btnWidth,
                 height = btnHeight,
                 text = "Lua Button!",
-                fontSize = 56,
-                borderWidth = 2,
-                borderRadius = 0.3,  -- 30% rounded corners
-                segments = 16,
-                useRoboto = true     -- Use roboto font
+                style = buttonStyle,
+                backgroundTween = buttonBackground,
+                borderTween = buttonBorder
             })
             
             return btnState
@@ -152,9 +818,12 @@ void initLua() {
 // Clean up Lua
 void cleanupLua() {
     if (L) {
+        cleanupTasks(L);
         lua_close(L);
         L = nullptr;
     }
+    luaDocuments.clear();
+    luaCharts.clear();
 }
 
 // Call a Lua function and return the result as a string
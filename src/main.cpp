@@ -1,5 +1,6 @@
 #include <cstdio>
 #include <emscripten.h>
+#include <emscripten/html5.h>
 #include <raylib.h>
 #include <raymath.h>
 
@@ -45,15 +46,115 @@ void setLogicalDimensions(int width, int height) {
 }
 
 // Include remaining components after global declarations
-#include "Elements/button.cpp"
+#include "utils/simd.cpp"
+#include "animation_manager.cpp"
 #include "font_manager.cpp"
+#include "style_manager.cpp"
+#include "Elements/button.cpp"
+#include "Elements/chart.cpp"
+#include "image_manager.cpp"
 #include "utils/colors.cpp"
 #include "utils/fps_counter.cpp"
+#include "utils/frame_stats.cpp"
 #include "utils/text_utils.cpp"
+#include "utils/paragraph_layout.cpp"
+#include "task_scheduler.cpp"
 #include "lua_manager.cpp"
 
+// Idle frame throttling - when nothing animates, no task or chart is busy
+// and there is no input, only redraw every IDLE_FRAME_INTERVAL display
+// refreshes
+const int IDLE_FRAME_THRESHOLD = 30; // quiet frames before throttling
+const int IDLE_FRAME_INTERVAL = 4;
+int idleFrames = 0;
+bool idleThrottled = false;
+
+void updateIdleThrottle() {
+#ifdef RAMLA_BENCHMARK
+  // Benchmark builds render every frame so frame time reports come at a
+  // steady rate
+  return;
+#endif
+
+  Vector2 mouseDelta = GetMouseDelta();
+  bool hasInput = mouseDelta.x != 0.0f || mouseDelta.y != 0.0f ||
+                  GetMouseWheelMove() != 0.0f ||
+                  IsMouseButtonDown(MOUSE_BUTTON_LEFT) ||
+                  IsMouseButtonReleased(MOUSE_BUTTON_LEFT);
+  // Always read (and so clear) the chart flag, even when input decides
+  bool chartsStreaming = chartsActive();
+
+  if (hasInput || animationsActive() || tasksPending() || chartsStreaming) {
+    idleFrames = 0;
+  } else if (idleFrames < IDLE_FRAME_THRESHOLD) {
+    idleFrames++;
+  }
+
+  bool shouldThrottle = idleFrames >= IDLE_FRAME_THRESHOLD;
+  if (shouldThrottle != idleThrottled) {
+    emscripten_set_main_loop_timing(EM_TIMING_RAF,
+                                    shouldThrottle ? IDLE_FRAME_INTERVAL : 1);
+    idleThrottled = shouldThrottle;
+  }
+}
+
+// raylib only samples input once per processed frame, so a click that
+// presses and releases between two throttled frames would never be seen.
+// Input events wake the loop as they arrive instead of waiting for the next
+// processed frame to notice them.
+static void wakeMainLoop() {
+  idleFrames = 0;
+  if (idleThrottled) {
+    emscripten_set_main_loop_timing(EM_TIMING_RAF, 1);
+    idleThrottled = false;
+  }
+}
+
+static EM_BOOL wakeOnMouse(int eventType, const EmscriptenMouseEvent *event,
+                           void *userData) {
+  wakeMainLoop();
+  return EM_FALSE; // let raylib/GLFW see the event too
+}
+
+static EM_BOOL wakeOnTouch(int eventType, const EmscriptenTouchEvent *event,
+                           void *userData) {
+  wakeMainLoop();
+  return EM_FALSE;
+}
+
+static EM_BOOL wakeOnKey(int eventType, const EmscriptenKeyboardEvent *event,
+                         void *userData) {
+  wakeMainLoop();
+  return EM_FALSE;
+}
+
+static EM_BOOL wakeOnWheel(int eventType, const EmscriptenWheelEvent *event,
+                           void *userData) {
+  wakeMainLoop();
+  return EM_FALSE;
+}
+
+// Registered on the window (capture phase) so they don't replace the canvas
+// callbacks raylib registers itself
+void registerWakeOnInput() {
+  const char *target = EMSCRIPTEN_EVENT_TARGET_WINDOW;
+  emscripten_set_mousedown_callback(target, nullptr, EM_TRUE, wakeOnMouse);
+  emscripten_set_touchstart_callback(target, nullptr, EM_TRUE, wakeOnTouch);
+  emscripten_set_keydown_callback(target, nullptr, EM_TRUE, wakeOnKey);
+  emscripten_set_wheel_callback(target, nullptr, EM_TRUE, wakeOnWheel);
+}
+
 // Main game loop function
 void UpdateDrawFrame() {
+  beginFrameTimer();
+  beginTaskFrame();
+
+  // Advance all tweens by the real time since the previous frame
+  updateAnimations(GetFrameTime());
+
+  // Upload images decoded by the workers since the last frame
+  updateImages();
+
   // Begin drawing
   BeginDrawing();
 
@@ -76,6 +177,7 @@ void UpdateDrawFrame() {
 
   if (btnState.clicked) {
     counter++;
+    signalTaskEvent(L, "click", 0);
   }
 
   // Draw counter text above the button (coordinates in "points")
@@ -104,20 +206,51 @@ void UpdateDrawFrame() {
   // Draw FPS counter in top right corner
   drawFpsCounterEx(screenWidth, screenHeight, &roboto);
 
+  // Show what background Lua tasks cost in the previous frame
+  if (getTaskCount() > 0) {
+    char taskText[64];
+    sprintf(taskText, "Tasks: %d (%.2f ms)", getTaskCount(),
+            getTaskRunMicros() / 1000.0);
+    DrawTextEx(roboto, taskText, (Vector2){10.0f, 10.0f}, 20.0f, 0.0f, GREEN);
+  }
+
   EndDrawing();
+
+  // Stop before the task scheduler - it fills whatever budget it is given,
+  // which would swamp the profile comparison
+  endFrameTimer();
+
+  // Resume Lua tasks in the time left after rendering
+  runTasks(L);
+
+  updateIdleThrottle();
 }
 
 int main() {
+  beginStartupTimer();
+
   // Initialize raylib - the canvas size will be handled by JavaScript
   InitWindow(screenWidth, screenHeight, "Ramla Engine");
 
   // Initialize fonts
   initFonts();
 
+  // Register the default theme and built-in styles (needs fonts)
+  initStyles();
+
+  // Start image decode workers
+  initImages();
+
   // Initialize Lua
   initLua();
 
-  // Set the game to run at 60 FPS
+  // Leave idle throttling as soon as the user interacts
+  registerWakeOnInput();
+
+  // Set the game to run at 60 FPS. Everything above is synchronous (fonts
+  // come from the embedded filesystem, images load on worker threads), so
+  // nothing needs ASYNCIFY - this call unwinds main() and the loop is driven
+  // by requestAnimationFrame.
   emscripten_set_main_loop(UpdateDrawFrame, FPS, 1);
 
   // Clean up fonts (this won't actually be called in browser, but good
@@ -127,5 +260,9 @@ int main() {
   // Clean up Lua
   cleanupLua();
 
+  unloadAnimations();
+
+  unloadImages();
+
   return 0;
 }
\ No newline at end of file
@@ -0,0 +1,213 @@
+#pragma once
+#include "utils/colors.cpp"
+#include <raylib.h>
+#include <string>
+#include <vector>
+
+// Precompiled widget styles. A style is registered once (from C++ or Lua),
+// resolved into an immutable record with every state variant worked out, and
+// referenced afterwards by integer handle. Each theme holds one record per
+// handle, so swapping the active theme restyles everything at once.
+
+// Defined in Elements/button.cpp
+Color adjustColor(Color color, float factor);
+
+// Interaction state variants precomputed for every style
+enum StyleVariant { STYLE_NORMAL = 0, STYLE_HOVER, STYLE_PRESSED, STYLE_VARIANTS };
+
+// What a style is registered from
+struct StyleDesc {
+  Color background;
+  Color hover;
+  Color pressed;
+  Color text;
+  Color border;
+  float borderWidth;  // logical pixels
+  float borderRadius; // 0.0f = no rounding, 1.0f = fully rounded
+  int segments;
+  int fontSize; // logical pixels
+  Font font;    // texture.id == 0 = default font
+};
+
+// Resolved, immutable style record
+struct Style {
+  Color background[STYLE_VARIANTS];
+  Color border[STYLE_VARIANTS];
+  Color text;
+  float borderWidth;
+  float borderRadius;
+  int segments;
+  int fontSize;
+  Font font;
+};
+
+// Handle 0 is "no style"; the built-in styles registered by initStyles() come
+// first
+const int STYLE_NONE = 0;
+const int STYLE_DEFAULT = 1;
+
+struct StyleManager {
+  std::vector<std::string> styleNames; // by handle - 1
+  std::vector<std::string> themeNames;
+  std::vector<std::vector<Style>> themes; // [theme][handle - 1]
+  int activeTheme;
+};
+
+static StyleManager styleManager;
+
+static Style resolveStyle(const StyleDesc &desc) {
+  Style style = {};
+
+  style.background[STYLE_NORMAL] = desc.background;
+  style.background[STYLE_HOVER] = desc.hover;
+  style.background[STYLE_PRESSED] = desc.pressed;
+
+  // Darker borders on hover, and darker still when pressed for an "inset"
+  // look - worked out here once instead of on every draw
+  style.border[STYLE_NORMAL] = desc.border;
+  style.border[STYLE_HOVER] = adjustColor(desc.hover, 0.8f);
+  style.border[STYLE_PRESSED] = adjustColor(desc.pressed, 0.6f);
+
+  style.text = desc.text;
+  style.borderWidth = desc.borderWidth;
+  style.borderRadius = desc.borderRadius;
+  style.segments = desc.segments;
+  style.fontSize = desc.fontSize;
+  style.font = desc.font;
+  return style;
+}
+
+int findTheme(const char *name) {
+  for (size_t i = 0; i < styleManager.themeNames.size(); i++) {
+    if (styleManager.themeNames[i] == name) {
+      return (int)i;
+    }
+  }
+  return -1;
+}
+
+// Create a theme (or find an existing one). New themes start as a copy of
+// the first theme, so they only need to override the styles they change.
+int registerTheme(const char *name) {
+  StyleManager &sm = styleManager;
+
+  int theme = findTheme(name);
+  if (theme >= 0) {
+    return theme;
+  }
+
+  sm.themeNames.push_back(name);
+  sm.themes.push_back(sm.themes.empty() ? std::vector<Style>()
+                                        : sm.themes[0]);
+  return (int)sm.themes.size() - 1;
+}
+
+int findStyle(const char *name) {
+  for (size_t i = 0; i < styleManager.styleNames.size(); i++) {
+    if (styleManager.styleNames[i] == name) {
+      return (int)i + 1;
+    }
+  }
+  return STYLE_NONE;
+}
+
+// Register (or replace) a named style in a theme and return its handle. A new
+// name registered in the first theme is the base every theme inherits until
+// it overrides it. A new name registered in another theme only looks that way
+// there; the other themes get their own "default" style for it.
+int registerStyle(int theme, const char *name, const StyleDesc &desc) {
+  StyleManager &sm = styleManager;
+
+  if (theme < 0 || theme >= (int)sm.themes.size()) {
+    return STYLE_NONE;
+  }
+
+  Style style = resolveStyle(desc);
+
+  int handle = findStyle(name);
+  if (handle == STYLE_NONE) {
+    bool hasDefault = !sm.styleNames.empty();
+    sm.styleNames.push_back(name);
+    for (size_t i = 0; i < sm.themes.size(); i++) {
+      std::vector<Style> &styles = sm.themes[i];
+      bool inherits = theme == 0 || (int)i == theme || !hasDefault;
+      Style seed = inherits ? style : styles[STYLE_DEFAULT - 1];
+      styles.push_back(seed);
+    }
+    return (int)sm.styleNames.size();
+  }
+
+  sm.themes[theme][handle - 1] = style;
+  return handle;
+}
+
+// Swap every style to the given theme's records
+bool setActiveTheme(int theme) {
+  if (theme < 0 || theme >= (int)styleManager.themes.size()) {
+    return false;
+  }
+  styleManager.activeTheme = theme;
+  return true;
+}
+
+// Resolve a handle against the active theme. The pointer is only valid until
+// the next style or theme registration.
+const Style *getStyle(int handle) {
+  const StyleManager &sm = styleManager;
+
+  if (handle <= STYLE_NONE || handle > (int)sm.styleNames.size()) {
+    return nullptr;
+  }
+  return &sm.themes[sm.activeTheme][handle - 1];
+}
+
+// Register the default theme and the built-in styles from the Colors palette
+void initStyles() {
+  StyleManager &sm = styleManager;
+
+  if (!sm.themes.empty()) {
+    return;
+  }
+
+  registerTheme("default");
+
+  Font roboto = getRobotoRegular();
+
+  // "default" keeps the look buttons had before styles existed
+  StyleDesc desc = {};
+  desc.background = (Color){74, 144, 226, 255};
+  desc.hover = (Color){94, 164, 246, 255};
+  desc.pressed = (Color){54, 124, 206, 255};
+  desc.text = Colors::Text::OnDark;
+  desc.border = (Color){100, 100, 100, 255};
+  desc.borderWidth = 2.0f;
+  desc.borderRadius = 0.3f;
+  desc.segments = 16;
+  desc.fontSize = 56;
+  desc.font = roboto;
+  registerStyle(0, "default", desc);
+
+  desc.background = Colors::Button::Default;
+  desc.hover = Colors::Button::DefaultHover;
+  desc.pressed = Colors::Button::DefaultPressed;
+  desc.border = Colors::Border::Default;
+  registerStyle(0, "primary", desc);
+
+  desc.background = Colors::Button::Success;
+  desc.hover = Colors::Button::SuccessHover;
+  desc.pressed = Colors::Button::SuccessPressed;
+  desc.border = Colors::Border::Success;
+  registerStyle(0, "success", desc);
+
+  desc.background = Colors::Button::Warning;
+  desc.hover = Colors::Button::WarningHover;
+  desc.pressed = Colors::Button::WarningPressed;
+  desc.border = Colors::Border::Warning;
+  registerStyle(0, "warning", desc);
+
+  desc.background = Colors::Button::Danger;
+  desc.hover = Colors::Button::DangerHover;
+  desc.pressed = Colors::Button::DangerPressed;
+  desc.border = Colors::Border::Danger;
+  registerStyle(0, "danger", desc);
+}
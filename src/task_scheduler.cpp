@@ -0,0 +1,396 @@
+#pragma once
+#include <lauxlib.h>
+#include <lua.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Cooperative Lua tasks. Scripts spawn() coroutines which yield(), sleep() or
+// await() engine events; the engine resumes them after the frame has been
+// drawn, within a time budget. An instruction count hook pre-empts tasks that
+// run past the budget without yielding.
+
+// Default per-frame budget for running tasks (microseconds)
+const double TASK_DEFAULT_BUDGET_MICROS = 4000.0;
+
+// Tasks always get at least this long, even when drawing ate the whole frame
+const double TASK_MIN_SLICE_MICROS = 500.0;
+
+// Frame length that "time left after rendering" is measured against
+const double TASK_TARGET_FRAME_MICROS = 1000000.0 / 60.0;
+
+// Sleepers due within this long count as pending for the idle throttle -
+// longer than one throttled frame interval, so the loop is back at full rate
+// before they wake
+const double TASK_WAKE_HORIZON_MICROS = 5.0 * TASK_TARGET_FRAME_MICROS;
+
+// Instructions between pre-emption checks
+const int TASK_HOOK_INSTRUCTIONS = 1000;
+
+enum class TaskState { Ready, Sleeping, Waiting, Dead };
+
+struct Task {
+  int id;
+  lua_State *thread;
+  int threadRef; // registry reference keeping the coroutine alive
+  TaskState state;
+  bool cancelled;
+  int resumeArgs;         // values on the thread stack for the next resume
+  double wakeTime;        // Sleeping: scheduler clock time to wake at
+  std::string awaitEvent; // Waiting: event name
+  double cpuMicros;       // total time spent running
+  double frameMicros;     // time spent running in the last scheduler pass
+  int preemptions;
+};
+
+struct TaskScheduler {
+  std::vector<Task> tasks;
+  int nextTaskId;
+  double budgetMicros;
+  double frameStart;
+  double sliceDeadline;
+  int currentTask; // index into tasks while a task runs, -1 otherwise
+  size_t nextTask; // where the next round starts, so no task always goes first
+  double lastRunMicros;
+};
+
+static TaskScheduler taskScheduler = {{}, 1, TASK_DEFAULT_BUDGET_MICROS,
+                                      0.0,  0.0, -1, 0, 0.0};
+
+static double schedulerNow() {
+  using namespace std::chrono;
+  return duration<double, std::micro>(
+             steady_clock::now().time_since_epoch())
+      .count();
+}
+
+static Task *currentTask(lua_State *L) {
+  TaskScheduler &ts = taskScheduler;
+  if (ts.currentTask < 0 || ts.tasks[ts.currentTask].thread != L) {
+    return nullptr;
+  }
+  return &ts.tasks[ts.currentTask];
+}
+
+// Count hook - yields the running task once its slice is used up. Yielding is
+// skipped inside non-yieldable calls (e.g. a table.sort comparator); the task
+// is pre-empted at the next check after it returns. Coroutines created by the
+// task inherit the hook but are never pre-empted, since yielding them would
+// return control to the task's own coroutine.resume() call.
+static void taskPreemptHook(lua_State *L, lua_Debug *ar) {
+  (void)ar;
+  if (schedulerNow() < taskScheduler.sliceDeadline || !lua_isyieldable(L)) {
+    return;
+  }
+
+  Task *task = currentTask(L);
+  if (task == nullptr) {
+    return;
+  }
+  task->preemptions++;
+  lua_yield(L, 0);
+}
+
+// Create a task running the function at the top of L's stack with `nargs`
+// arguments above it. Pops the function and arguments. Returns the task id.
+int spawnTask(lua_State *L, int nargs) {
+  TaskScheduler &ts = taskScheduler;
+
+  lua_State *thread = lua_newthread(L);
+  int threadRef = luaL_ref(L, LUA_REGISTRYINDEX);
+  lua_xmove(L, thread, nargs + 1);
+  lua_sethook(thread, taskPreemptHook, LUA_MASKCOUNT, TASK_HOOK_INSTRUCTIONS);
+
+  Task task = {};
+  task.id = ts.nextTaskId++;
+  task.thread = thread;
+  task.threadRef = threadRef;
+  task.state = TaskState::Ready;
+  task.resumeArgs = nargs;
+  ts.tasks.push_back(task);
+  return task.id;
+}
+
+// Wake every task awaiting `event`, passing it the `nargs` values at the top
+// of L's stack. The values are left on L's stack.
+void signalTaskEvent(lua_State *L, const char *event, int nargs) {
+  int top = lua_gettop(L);
+
+  for (Task &task : taskScheduler.tasks) {
+    if (task.state != TaskState::Waiting || task.awaitEvent != event) {
+      continue;
+    }
+
+    for (int i = top - nargs + 1; i <= top; i++) {
+      lua_pushvalue(L, i);
+    }
+    lua_xmove(L, task.thread, nargs);
+    task.resumeArgs = nargs;
+    task.state = TaskState::Ready;
+    task.awaitEvent.clear();
+  }
+}
+
+// Stop a task. It is released at the end of the current scheduler pass; a
+// task may cancel itself.
+void cancelTask(int id) {
+  for (Task &task : taskScheduler.tasks) {
+    if (task.id == id) {
+      task.cancelled = true;
+      task.state = TaskState::Dead;
+    }
+  }
+}
+
+// Mark the start of a frame - the task budget is measured from here
+void beginTaskFrame() { taskScheduler.frameStart = schedulerNow(); }
+
+void setTaskBudget(double micros) {
+  taskScheduler.budgetMicros = std::max(0.0, micros);
+}
+
+// Ready, or sleeping and due to wake
+static bool isTaskRunnable(const Task &task, double now) {
+  return task.state == TaskState::Ready ||
+         (task.state == TaskState::Sleeping && now >= task.wakeTime);
+}
+
+static void resumeTask(lua_State *L, size_t index) {
+  TaskScheduler &ts = taskScheduler;
+
+  lua_State *thread = ts.tasks[index].thread;
+  int nargs = ts.tasks[index].resumeArgs;
+  ts.tasks[index].resumeArgs = 0;
+  ts.currentTask = (int)index;
+
+  double start = schedulerNow();
+  int nresults = 0;
+  int status = lua_resume(thread, L, nargs, &nresults);
+  double elapsed = schedulerNow() - start;
+
+  ts.currentTask = -1;
+
+  // Spawning from inside the task may have reallocated the task list
+  Task &task = ts.tasks[index];
+  task.cpuMicros += elapsed;
+  task.frameMicros += elapsed;
+
+  if (status == LUA_YIELD) {
+    lua_pop(thread, nresults);
+    // sleep()/await() already set their state; plain yields and
+    // pre-emptions stay runnable
+    if (task.cancelled) {
+      task.state = TaskState::Dead;
+    }
+    return;
+  }
+
+  if (status != LUA_OK) {
+    luaL_traceback(L, thread, lua_tostring(thread, -1), 0);
+    printf("Lua task %d error: %s\n", task.id, lua_tostring(L, -1));
+    lua_pop(L, 1);
+  }
+  task.state = TaskState::Dead;
+}
+
+// Resume runnable tasks until the budget runs out. Call after the frame has
+// been drawn. Tasks must not draw. Tasks awaiting "frame" wake on every call.
+void runTasks(lua_State *L) {
+  TaskScheduler &ts = taskScheduler;
+
+  double start = schedulerNow();
+  signalTaskEvent(L, "frame", 0);
+
+  double frameLeft = TASK_TARGET_FRAME_MICROS - (start - ts.frameStart);
+  double budget = std::min(ts.budgetMicros,
+                           std::max(frameLeft, TASK_MIN_SLICE_MICROS));
+  double deadline = start + budget;
+
+  for (Task &task : ts.tasks) {
+    task.frameMicros = 0.0;
+  }
+
+  // Round robin until nothing is runnable or time is up. Each resume gets at
+  // most an equal share of the pass budget (budget / runnable tasks, cut
+  // short by the pass deadline), and rounds start where the last one stopped
+  // (across frames too), so a task that never yields can't starve the
+  // others. Tasks spawned during a round run in the next one.
+  bool progressed = true;
+  while (progressed && schedulerNow() < deadline) {
+    progressed = false;
+
+    size_t count = ts.tasks.size();
+    size_t runnable = 0;
+    double now = schedulerNow();
+    for (size_t i = 0; i < count; i++) {
+      if (isTaskRunnable(ts.tasks[i], now)) {
+        runnable++;
+      }
+    }
+    if (runnable == 0) {
+      break;
+    }
+
+    size_t first = ts.nextTask % count;
+    for (size_t n = 0; n < count; n++) {
+      size_t i = (first + n) % count;
+      now = schedulerNow();
+      if (now >= deadline) {
+        break;
+      }
+      if (!isTaskRunnable(ts.tasks[i], now)) {
+        continue;
+      }
+
+      ts.tasks[i].state = TaskState::Ready;
+      ts.sliceDeadline = std::min(deadline, now + budget / runnable);
+      resumeTask(L, i);
+      ts.nextTask = i + 1;
+      progressed = true;
+    }
+  }
+
+  // Drop finished tasks and release their coroutines
+  for (const Task &task : ts.tasks) {
+    if (task.state == TaskState::Dead) {
+      luaL_unref(L, LUA_REGISTRYINDEX, task.threadRef);
+    }
+  }
+  ts.tasks.erase(std::remove_if(ts.tasks.begin(), ts.tasks.end(),
+                                [](const Task &task) {
+                                  return task.state == TaskState::Dead;
+                                }),
+                 ts.tasks.end());
+
+  ts.lastRunMicros = schedulerNow() - start;
+}
+
+int getTaskCount() { return (int)taskScheduler.tasks.size(); }
+
+// Whether any task wants to run soon - runnable, waking within a few frames
+// or waiting for the next frame. The idle throttle stays off while this is
+// true; long sleeps don't hold it off.
+bool tasksPending() {
+  double horizon = schedulerNow() + TASK_WAKE_HORIZON_MICROS;
+  for (const Task &task : taskScheduler.tasks) {
+    if (task.state == TaskState::Ready ||
+        (task.state == TaskState::Sleeping && task.wakeTime <= horizon) ||
+        (task.state == TaskState::Waiting && task.awaitEvent == "frame")) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Wall time the last runTasks() call took (microseconds)
+double getTaskRunMicros() { return taskScheduler.lastRunMicros; }
+
+// Lua bindings
+
+// spawn(fn, ...) -> task id
+static int lua_spawn(lua_State *L) {
+  luaL_checktype(L, 1, LUA_TFUNCTION);
+  lua_pushinteger(L, spawnTask(L, lua_gettop(L) - 1));
+  return 1;
+}
+
+static Task *checkCurrentTask(lua_State *L, const char *function) {
+  Task *task = currentTask(L);
+  if (task == nullptr) {
+    luaL_error(L, "%s() can only be called from a task started with spawn()",
+               function);
+  }
+  return task;
+}
+
+// yield() - let other tasks run, resume in the same or a later frame
+static int lua_taskYield(lua_State *L) {
+  checkCurrentTask(L, "yield");
+  return lua_yield(L, 0);
+}
+
+// sleep(seconds)
+static int lua_taskSleep(lua_State *L) {
+  Task *task = checkCurrentTask(L, "sleep");
+  task->state = TaskState::Sleeping;
+  task->wakeTime = schedulerNow() + luaL_checknumber(L, 1) * 1000000.0;
+  return lua_yield(L, 0);
+}
+
+// await(event) -> values passed to signal()
+static int lua_taskAwait(lua_State *L) {
+  Task *task = checkCurrentTask(L, "await");
+  task->state = TaskState::Waiting;
+  task->awaitEvent = luaL_checkstring(L, 1);
+  return lua_yield(L, 0);
+}
+
+// signal(event, ...) - wake tasks awaiting event
+static int lua_taskSignal(lua_State *L) {
+  signalTaskEvent(L, luaL_checkstring(L, 1), lua_gettop(L) - 1);
+  return 0;
+}
+
+// cancelTask(id)
+static int lua_cancelTask(lua_State *L) {
+  cancelTask(luaL_checkinteger(L, 1));
+  return 0;
+}
+
+// setTaskBudget(microseconds)
+static int lua_setTaskBudget(lua_State *L) {
+  setTaskBudget(luaL_checknumber(L, 1));
+  return 0;
+}
+
+// taskStats() -> {{id, status, cpuTime, frameTime, preemptions}, ...}, times
+// in milliseconds
+static int lua_taskStats(lua_State *L) {
+  static const char *stateNames[] = {"ready", "sleeping", "waiting", "dead"};
+
+  lua_createtable(L, (int)taskScheduler.tasks.size(), 0);
+  int index = 1;
+  for (const Task &task : taskScheduler.tasks) {
+    lua_newtable(L);
+
+    lua_pushinteger(L, task.id);
+    lua_setfield(L, -2, "id");
+
+    lua_pushstring(L, stateNames[(int)task.state]);
+    lua_setfield(L, -2, "status");
+
+    lua_pushnumber(L, task.cpuMicros / 1000.0);
+    lua_setfield(L, -2, "cpuTime");
+
+    lua_pushnumber(L, task.frameMicros / 1000.0);
+    lua_setfield(L, -2, "frameTime");
+
+    lua_pushinteger(L, task.preemptions);
+    lua_setfield(L, -2, "preemptions");
+
+    lua_rawseti(L, -2, index++);
+  }
+  return 1;
+}
+
+void registerTaskScheduler(lua_State *L) {
+  lua_register(L, "spawn", lua_spawn);
+  lua_register(L, "yield", lua_taskYield);
+  lua_register(L, "sleep", lua_taskSleep);
+  lua_register(L, "await", lua_taskAwait);
+  lua_register(L, "signal", lua_taskSignal);
+  lua_register(L, "cancelTask", lua_cancelTask);
+  lua_register(L, "setTaskBudget", lua_setTaskBudget);
+  lua_register(L, "taskStats", lua_taskStats);
+}
+
+// Release every task's coroutine
+void cleanupTasks(lua_State *L) {
+  for (const Task &task : taskScheduler.tasks) {
+    luaL_unref(L, LUA_REGISTRYINDEX, task.threadRef);
+  }
+  taskScheduler.tasks.clear();
+}
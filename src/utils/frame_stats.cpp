@@ -0,0 +1,73 @@
+#pragma once
+#include <cstdio>
+#include <emscripten.h>
+
+// Startup and frame time reporting for comparing build profiles. Built with
+// -DRAMLA_BENCHMARK (make BENCH=1) it prints to the console, one line per
+// report, so a headless browser run can scrape the numbers:
+//
+//   BENCH startup page=412.3ms main=38.9ms
+//   BENCH frames=600 avg=1.204ms max=3.870ms
+//
+// "page" is navigation start to the first finished frame, "main" is main()
+// to the first finished frame. Frame times are CPU time inside the frame
+// callback up to EndDrawing(), not the display interval; idle throttling is
+// off in these builds. bench.py runs builds headlessly and collects the
+// lines. Without the define it compiles away.
+
+// Frames per frame time report
+const int FRAME_STATS_INTERVAL = 600;
+
+#ifdef RAMLA_BENCHMARK
+
+struct FrameStats {
+  double mainStart;
+  double frameStart;
+  bool startupReported;
+  int frames;
+  double totalMillis;
+  double maxMillis;
+};
+
+static FrameStats frameStats;
+
+// Call first thing in main()
+void beginStartupTimer() { frameStats.mainStart = emscripten_get_now(); }
+
+void beginFrameTimer() { frameStats.frameStart = emscripten_get_now(); }
+
+// Call at the very end of the frame callback
+void endFrameTimer() {
+  FrameStats &fs = frameStats;
+  double now = emscripten_get_now();
+
+  if (!fs.startupReported) {
+    printf("BENCH startup page=%.1fms main=%.1fms\n", now,
+           now - fs.mainStart);
+    fs.startupReported = true;
+    return;
+  }
+
+  double elapsed = now - fs.frameStart;
+  fs.frames++;
+  fs.totalMillis += elapsed;
+  if (elapsed > fs.maxMillis) {
+    fs.maxMillis = elapsed;
+  }
+
+  if (fs.frames == FRAME_STATS_INTERVAL) {
+    printf("BENCH frames=%d avg=%.3fms max=%.3fms\n", fs.frames,
+           fs.totalMillis / fs.frames, fs.maxMillis);
+    fs.frames = 0;
+    fs.totalMillis = 0.0;
+    fs.maxMillis = 0.0;
+  }
+}
+
+#else
+
+inline void beginStartupTimer() {}
+inline void beginFrameTimer() {}
+inline void endFrameTimer() {}
+
+#endif
@@ -0,0 +1,517 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <raylib.h>
+#include <string>
+#include <vector>
+
+// Multi-paragraph text layout with wrapping, alignment, line height and
+// ellipsis truncation. Line breaks are cached per paragraph for the current
+// width/font/size; edits relayout only from the line before the edit and stop
+// as soon as the new breaks line up with the old ones again.
+
+enum class TextAlign : uint8_t { Left, Center, Right };
+
+struct ParagraphStyle {
+  Font font;
+  float fontSize;   // logical pixels
+  float lineHeight; // multiple of the font size
+  TextAlign align;
+  bool wrap;    // false = one line per paragraph, truncated with an ellipsis
+  int maxLines; // per paragraph, 0 = unlimited; overflow ends in an ellipsis
+};
+
+// One laid out line - a byte range of its paragraph
+struct TextLine {
+  uint32_t start;
+  uint32_t end;      // exclusive, trailing break spaces not included
+  float width;       // physical pixels, ellipsis included
+  bool ellipsis;     // draw "..." after the range
+};
+
+struct Paragraph {
+  std::string text;
+  std::vector<TextLine> lines; // empty = needs layout
+};
+
+struct TextDocument {
+  std::vector<Paragraph> paragraphs;
+  std::vector<uint32_t> firstLine; // document line index of each paragraph
+  ParagraphStyle style;
+
+  // Layout parameters the cached lines were built for (physical pixels)
+  float layoutWidth;
+  float layoutFontSize;
+  unsigned int layoutFontTexture;
+  size_t dirtyFrom; // first paragraph whose firstLine entry is stale
+
+  float asciiAdvance[128]; // physical advance of each ASCII codepoint
+  float ellipsisWidth;
+};
+
+static const char *ELLIPSIS = "...";
+
+// Same advance rule as MeasureTextEx, in physical pixels
+static float glyphAdvance(const TextDocument *doc, int codepoint) {
+  const Font &font = doc->style.font;
+  int index = GetGlyphIndex(font, codepoint);
+  float advance = font.glyphs[index].advanceX != 0
+                      ? (float)font.glyphs[index].advanceX
+                      : font.recs[index].width + font.glyphs[index].offsetX;
+  return advance * doc->layoutFontSize / (float)font.baseSize;
+}
+
+static float codepointAdvance(const TextDocument *doc, int codepoint) {
+  if (codepoint >= 0 && codepoint < 128) {
+    return doc->asciiAdvance[codepoint];
+  }
+  return glyphAdvance(doc, codepoint);
+}
+
+// GetGlyphIndex is a linear search, so ASCII advances are looked up once per
+// font/size change instead of once per character
+static void cacheAdvances(TextDocument *doc) {
+  for (int codepoint = 0; codepoint < 128; codepoint++) {
+    doc->asciiAdvance[codepoint] = glyphAdvance(doc, codepoint);
+  }
+  doc->ellipsisWidth = doc->asciiAdvance[(int)'.'] * 3.0f;
+}
+
+// Shorten a line until it fits `maxWidth` together with the ellipsis
+static void truncateLine(const TextDocument *doc, const std::string &text,
+                         TextLine *line, float maxWidth) {
+  float width = 0.0f;
+  uint32_t end = line->start;
+  uint32_t pos = line->start;
+
+  while (pos < line->end) {
+    int size = 0;
+    int codepoint = GetCodepointNext(text.c_str() + pos, &size);
+    float advance = codepointAdvance(doc, codepoint);
+    if (width + advance + doc->ellipsisWidth > maxWidth) {
+      break;
+    }
+    width += advance;
+    pos += size;
+    end = pos;
+  }
+
+  line->end = end;
+  line->width = width + doc->ellipsisWidth;
+  line->ellipsis = true;
+}
+
+// Greedy line breaking of `paragraph` starting at byte `start`. New lines are
+// appended to `lines`. `resync` holds the old lines that follow the edit, with
+// starts already shifted into new coordinates - once a new line starts where
+// one of them does, the rest of the old layout is reused as is.
+static void breakLines(const TextDocument *doc, const Paragraph &paragraph,
+                       uint32_t start, std::vector<TextLine> &lines,
+                       const std::vector<TextLine> &resync,
+                       uint32_t resyncAfter) {
+  const std::string &text = paragraph.text;
+  const uint32_t length = (uint32_t)text.size();
+  const float maxWidth = doc->layoutWidth;
+  const int maxLines = doc->style.maxLines;
+  size_t resyncIndex = 0;
+
+  if (!doc->style.wrap) {
+    TextLine line = {start, length, 0.0f, false};
+    uint32_t pos = start;
+    while (pos < length) {
+      int size = 0;
+      line.width += codepointAdvance(doc, GetCodepointNext(&text[pos], &size));
+      pos += size;
+    }
+    if (line.width > maxWidth) {
+      truncateLine(doc, text, &line, maxWidth);
+    }
+    lines.push_back(line);
+    return;
+  }
+
+  uint32_t lineStart = start;
+  uint32_t pos = start;
+  float lineWidth = 0.0f;
+  uint32_t breakEnd = start;   // end of the text before the last space run
+  uint32_t breakStart = start; // first byte after that space run
+  float breakWidth = 0.0f;     // line width up to breakEnd
+  float widthAtBreakStart = 0.0f;
+
+  while (pos < length) {
+    int size = 0;
+    int codepoint = GetCodepointNext(&text[pos], &size);
+    float advance = codepointAdvance(doc, codepoint);
+
+    // Spaces never start a new line - they hang off the end of the old one
+    if (codepoint == ' ') {
+      if (breakStart != pos) {
+        breakEnd = pos;
+        breakWidth = lineWidth;
+      }
+      lineWidth += advance;
+      pos += size;
+      breakStart = pos;
+      widthAtBreakStart = lineWidth;
+      continue;
+    }
+
+    if (lineWidth + advance <= maxWidth || pos == lineStart) {
+      lineWidth += advance;
+      pos += size;
+      continue;
+    }
+
+    TextLine line;
+    if (breakStart > lineStart && breakEnd > lineStart) {
+      // Break at the last space run; the word in progress moves down
+      line = {lineStart, breakEnd, breakWidth, false};
+      lineWidth -= widthAtBreakStart;
+      lineStart = breakStart;
+    } else {
+      // A single word wider than the line - break inside it
+      line = {lineStart, pos, lineWidth, false};
+      lineWidth = 0.0f;
+      lineStart = pos;
+    }
+    breakStart = breakEnd = lineStart;
+
+    if (maxLines > 0 && (int)lines.size() + 1 >= maxLines) {
+      line.end = length;
+      truncateLine(doc, text, &line, maxWidth);
+      lines.push_back(line);
+      return;
+    }
+    lines.push_back(line);
+
+    // Greedy breaking only depends on where a line starts, so once a new line
+    // starts where an old one did the rest of the old layout still holds
+    if (lineStart > resyncAfter && maxLines == 0) {
+      while (resyncIndex < resync.size() &&
+             resync[resyncIndex].start < lineStart) {
+        resyncIndex++;
+      }
+      if (resyncIndex < resync.size() &&
+          resync[resyncIndex].start == lineStart) {
+        lines.insert(lines.end(), resync.begin() + resyncIndex, resync.end());
+        return;
+      }
+    }
+  }
+
+  lines.push_back({lineStart, length, lineWidth, false});
+}
+
+static void layoutParagraph(const TextDocument *doc, Paragraph &paragraph) {
+  static const std::vector<TextLine> noResync;
+  paragraph.lines.clear();
+  breakLines(doc, paragraph, 0, paragraph.lines, noResync, 0);
+}
+
+static void markParagraphsFrom(TextDocument *doc, size_t index) {
+  doc->dirtyFrom = std::min(doc->dirtyFrom, index);
+}
+
+// Relayout `paragraph` after `oldLength` bytes at `offset` were replaced by
+// `newLength` bytes
+static void relayoutParagraphEdit(TextDocument *doc, Paragraph &paragraph,
+                                  uint32_t offset, uint32_t oldLength,
+                                  uint32_t newLength) {
+  if (paragraph.lines.empty() || doc->layoutWidth <= 0.0f) {
+    paragraph.lines.clear();
+    return;
+  }
+
+  std::vector<TextLine> &lines = paragraph.lines;
+
+  // Restart one line early - shortening the first word of a line can pull it
+  // up onto the previous line
+  size_t editLine = 0;
+  while (editLine + 1 < lines.size() && lines[editLine + 1].start <= offset) {
+    editLine++;
+  }
+  size_t restartLine = editLine > 0 ? editLine - 1 : 0;
+  uint32_t restartOffset = lines[restartLine].start;
+
+  // Old lines starting after the edited range, moved to new offsets
+  std::vector<TextLine> resync;
+  int64_t delta = (int64_t)newLength - (int64_t)oldLength;
+  for (size_t i = editLine + 1; i < lines.size(); i++) {
+    if (lines[i].start > offset + oldLength) {
+      TextLine line = lines[i];
+      line.start = (uint32_t)(line.start + delta);
+      line.end = (uint32_t)(line.end + delta);
+      resync.push_back(line);
+    }
+  }
+
+  lines.resize(restartLine);
+  breakLines(doc, paragraph, restartOffset, lines, resync,
+             offset + newLength);
+}
+
+// Lay out every paragraph that needs it for `logicalWidth` and refresh line
+// offsets. Cheap when nothing changed.
+void layoutDocument(TextDocument *doc, float logicalWidth) {
+  float scale = getScaleFactor();
+  float width = roundf(logicalWidth * scale);
+  float fontSize = roundf(doc->style.fontSize * scale);
+
+  if (doc->style.font.texture.id == 0) {
+    doc->style.font = GetFontDefault();
+  }
+
+  // Width, size or font changes invalidate every cached break
+  if (width != doc->layoutWidth || fontSize != doc->layoutFontSize ||
+      doc->style.font.texture.id != doc->layoutFontTexture) {
+    doc->layoutWidth = width;
+    doc->layoutFontSize = fontSize;
+    doc->layoutFontTexture = doc->style.font.texture.id;
+    cacheAdvances(doc);
+    for (Paragraph &paragraph : doc->paragraphs) {
+      paragraph.lines.clear();
+    }
+    doc->dirtyFrom = 0;
+  }
+
+  if (doc->dirtyFrom >= doc->paragraphs.size() &&
+      doc->firstLine.size() == doc->paragraphs.size()) {
+    return;
+  }
+
+  doc->firstLine.resize(doc->paragraphs.size());
+  uint32_t line = doc->dirtyFrom > 0
+                      ? doc->firstLine[doc->dirtyFrom - 1] +
+                            (uint32_t)doc->paragraphs[doc->dirtyFrom - 1]
+                                .lines.size()
+                      : 0;
+
+  for (size_t i = doc->dirtyFrom; i < doc->paragraphs.size(); i++) {
+    Paragraph &paragraph = doc->paragraphs[i];
+    if (paragraph.lines.empty()) {
+      layoutParagraph(doc, paragraph);
+    }
+    doc->firstLine[i] = line;
+    line += (uint32_t)paragraph.lines.size();
+  }
+
+  doc->dirtyFrom = doc->paragraphs.size();
+}
+
+static void splitIntoParagraphs(TextDocument *doc, size_t index,
+                                const char *text) {
+  // Text after each newline starts a new paragraph inserted after `index`
+  const char *newline = strchr(text, '\n');
+  while (newline != nullptr) {
+    const char *next = newline + 1;
+    const char *end = strchr(next, '\n');
+    Paragraph paragraph;
+    paragraph.text.assign(next, end ? end - next : strlen(next));
+    doc->paragraphs.insert(doc->paragraphs.begin() + (++index), paragraph);
+    newline = end;
+  }
+}
+
+// Replace the whole document
+void setDocumentText(TextDocument *doc, const char *text) {
+  doc->paragraphs.clear();
+  doc->paragraphs.push_back(Paragraph{});
+  const char *newline = strchr(text, '\n');
+  doc->paragraphs[0].text.assign(text, newline ? newline - text
+                                               : strlen(text));
+  splitIntoParagraphs(doc, 0, text);
+  doc->firstLine.clear();
+  doc->dirtyFrom = 0;
+}
+
+// Append text to the end of the document - the typical log viewer path. Only
+// the last paragraph and new ones are laid out again.
+void appendDocumentText(TextDocument *doc, const char *text) {
+  if (doc->paragraphs.empty()) {
+    doc->paragraphs.push_back(Paragraph{});
+  }
+
+  size_t last = doc->paragraphs.size() - 1;
+  Paragraph &tail = doc->paragraphs[last];
+  const char *newline = strchr(text, '\n');
+  uint32_t offset = (uint32_t)tail.text.size();
+  uint32_t length = (uint32_t)(newline ? newline - text : strlen(text));
+  tail.text.append(text, length);
+  relayoutParagraphEdit(doc, tail, offset, 0, length);
+
+  splitIntoParagraphs(doc, last, text);
+  markParagraphsFrom(doc, last);
+}
+
+// Insert text at a byte offset of a paragraph. Newlines split the paragraph.
+void insertDocumentText(TextDocument *doc, size_t paragraphIndex,
+                        size_t offset, const char *text) {
+  if (paragraphIndex >= doc->paragraphs.size()) {
+    return;
+  }
+
+  Paragraph &paragraph = doc->paragraphs[paragraphIndex];
+  offset = std::min(offset, paragraph.text.size());
+
+  const char *newline = strchr(text, '\n');
+  if (newline == nullptr) {
+    uint32_t length = (uint32_t)strlen(text);
+    paragraph.text.insert(offset, text, length);
+    relayoutParagraphEdit(doc, paragraph, (uint32_t)offset, 0, length);
+    markParagraphsFrom(doc, paragraphIndex);
+    return;
+  }
+
+  // The text after the insertion point moves to the last new paragraph
+  std::string rest = paragraph.text.substr(offset);
+  paragraph.text.resize(offset);
+  paragraph.text.append(text, newline - text);
+  paragraph.lines.clear();
+
+  splitIntoParagraphs(doc, paragraphIndex, text);
+  size_t lastIndex = paragraphIndex + std::count(text, text + strlen(text), '\n');
+  doc->paragraphs[lastIndex].text.append(rest);
+  markParagraphsFrom(doc, paragraphIndex);
+}
+
+// Erase `length` bytes starting at a byte offset of a paragraph. Each
+// paragraph break counts as one byte, so erasing past the end of a paragraph
+// joins the following ones onto it.
+void eraseDocumentText(TextDocument *doc, size_t paragraphIndex,
+                       size_t offset, size_t length) {
+  if (paragraphIndex >= doc->paragraphs.size() || length == 0) {
+    return;
+  }
+
+  Paragraph &paragraph = doc->paragraphs[paragraphIndex];
+  offset = std::min(offset, paragraph.text.size());
+
+  // Find where the erased range ends
+  size_t endIndex = paragraphIndex;
+  size_t endOffset = offset;
+  size_t remaining = length;
+  while (true) {
+    size_t available = doc->paragraphs[endIndex].text.size() - endOffset;
+    if (remaining <= available) {
+      endOffset += remaining;
+      break;
+    }
+    if (endIndex + 1 >= doc->paragraphs.size()) {
+      endOffset += available;
+      break;
+    }
+    remaining -= available + 1;
+    endIndex++;
+    endOffset = 0;
+  }
+
+  if (endIndex == paragraphIndex) {
+    paragraph.text.erase(offset, endOffset - offset);
+    relayoutParagraphEdit(doc, paragraph, (uint32_t)offset,
+                          (uint32_t)(endOffset - offset), 0);
+    markParagraphsFrom(doc, paragraphIndex);
+    return;
+  }
+
+  // Join: the rest of the last paragraph replaces everything after `offset`,
+  // and the paragraphs in between go away. Lines before the join point are
+  // kept.
+  uint32_t oldLength = (uint32_t)(paragraph.text.size() - offset);
+  const std::string &tail = doc->paragraphs[endIndex].text;
+  uint32_t newLength = (uint32_t)(tail.size() - endOffset);
+  paragraph.text.replace(offset, std::string::npos, tail, endOffset,
+                         std::string::npos);
+  doc->paragraphs.erase(doc->paragraphs.begin() + paragraphIndex + 1,
+                        doc->paragraphs.begin() + endIndex + 1);
+
+  Paragraph &joined = doc->paragraphs[paragraphIndex];
+  relayoutParagraphEdit(doc, joined, (uint32_t)offset, oldLength, newLength);
+  markParagraphsFrom(doc, paragraphIndex);
+}
+
+float getDocumentLineHeight(const TextDocument *doc) {
+  return roundf(doc->layoutFontSize * doc->style.lineHeight);
+}
+
+// Total laid out height in physical pixels (valid after layoutDocument)
+float getDocumentHeight(const TextDocument *doc) {
+  if (doc->paragraphs.empty() || doc->firstLine.empty()) {
+    return 0.0f;
+  }
+  uint32_t lineCount =
+      doc->firstLine.back() + (uint32_t)doc->paragraphs.back().lines.size();
+  return lineCount * getDocumentLineHeight(doc);
+}
+
+// Lay out and draw the document into logical `bounds`, scrolled down by
+// `scrollY` logical pixels. Only visible lines are touched.
+void drawDocument(TextDocument *doc, Rectangle bounds, float scrollY,
+                  Color color) {
+  layoutDocument(doc, bounds.width);
+
+  if (doc->paragraphs.empty()) {
+    return;
+  }
+
+  // Convert logical coordinates to physical coordinates
+  float scale = getScaleFactor();
+  float physicalX = roundf(bounds.x * scale);
+  float physicalY = roundf(bounds.y * scale);
+  float physicalHeight = roundf(bounds.height * scale);
+  float physicalScroll = roundf(scrollY * scale);
+  float lineHeight = getDocumentLineHeight(doc);
+  if (lineHeight <= 0.0f) {
+    return;
+  }
+
+  // Find the paragraph holding the first visible line
+  uint32_t firstVisible = (uint32_t)fmaxf(0.0f, physicalScroll / lineHeight);
+  size_t paragraphIndex =
+      std::upper_bound(doc->firstLine.begin(), doc->firstLine.end(),
+                       firstVisible) -
+      doc->firstLine.begin();
+  paragraphIndex = paragraphIndex > 0 ? paragraphIndex - 1 : 0;
+
+  // Line glyph offsets are vertically centered within the line height
+  float glyphOffset = roundf((lineHeight - doc->layoutFontSize) / 2.0f);
+
+  static std::string scratch;
+  BeginScissorMode((int)physicalX, (int)physicalY, (int)doc->layoutWidth,
+                   (int)physicalHeight);
+
+  for (; paragraphIndex < doc->paragraphs.size(); paragraphIndex++) {
+    const Paragraph &paragraph = doc->paragraphs[paragraphIndex];
+    uint32_t lineIndex = doc->firstLine[paragraphIndex];
+
+    for (const TextLine &line : paragraph.lines) {
+      float y = physicalY + lineIndex * lineHeight - physicalScroll;
+      lineIndex++;
+      if (y + lineHeight <= physicalY) {
+        continue;
+      }
+      if (y >= physicalY + physicalHeight) {
+        EndScissorMode();
+        return;
+      }
+
+      float x = physicalX;
+      if (doc->style.align == TextAlign::Center) {
+        x += roundf((doc->layoutWidth - line.width) / 2.0f);
+      } else if (doc->style.align == TextAlign::Right) {
+        x += doc->layoutWidth - line.width;
+      }
+
+      scratch.assign(paragraph.text, line.start, line.end - line.start);
+      if (line.ellipsis) {
+        scratch.append(ELLIPSIS);
+      }
+      DrawTextEx(doc->style.font, scratch.c_str(),
+                 (Vector2){roundf(x), y + glyphOffset}, doc->layoutFontSize,
+                 0.0f, color);
+    }
+  }
+
+  EndScissorMode();
+}
@@ -0,0 +1,126 @@
+#pragma once
+#include <cmath>
+#include <raylib.h>
+
+#if defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#endif
+
+// 4-wide kernels for the hottest per-frame math. Built with -msimd128 (the
+// release web profile) they use Wasm SIMD; otherwise they fall back to the
+// scalar code they replace. Both paths round like roundf (halfway cases away
+// from zero) so the two builds place pixels identically.
+
+// out[i] = roundf(in[i] * scale) for 4 values
+inline void scaleRound4(const float *in, float scale, float *out) {
+#if defined(__wasm_simd128__)
+  v128_t v = wasm_f32x4_mul(wasm_v128_load(in), wasm_f32x4_splat(scale));
+
+  // trunc, then step away from zero when the dropped fraction is >= 0.5
+  v128_t truncated = wasm_f32x4_trunc(v);
+  v128_t fraction = wasm_f32x4_abs(wasm_f32x4_sub(v, truncated));
+  v128_t roundAway = wasm_f32x4_ge(fraction, wasm_f32x4_splat(0.5f));
+  v128_t signBit = wasm_v128_and(v, wasm_i32x4_splat((int)0x80000000));
+  v128_t step = wasm_v128_and(
+      roundAway, wasm_v128_or(wasm_f32x4_splat(1.0f), signBit));
+  wasm_v128_store(out, wasm_f32x4_add(truncated, step));
+#else
+  out[0] = roundf(in[0] * scale);
+  out[1] = roundf(in[1] * scale);
+  out[2] = roundf(in[2] * scale);
+  out[3] = roundf(in[3] * scale);
+#endif
+}
+
+// Logical rectangle to whole physical pixels
+inline Rectangle scaleRectRound(Rectangle rect, float scale) {
+  float in[4] = {rect.x, rect.y, rect.width, rect.height};
+  float out[4];
+  scaleRound4(in, scale, out);
+  return (Rectangle){out[0], out[1], out[2], out[3]};
+}
+
+// out[i] = base - (in[i] - offset) * scale, e.g. data values to screen y.
+// NaNs (gaps) pass through.
+inline void mapLinear(const float *in, float *out, int count, float offset,
+                      float scale, float base) {
+  int i = 0;
+#if defined(__wasm_simd128__)
+  v128_t offsetV = wasm_f32x4_splat(offset);
+  v128_t scaleV = wasm_f32x4_splat(scale);
+  v128_t baseV = wasm_f32x4_splat(base);
+  for (; i + 4 <= count; i += 4) {
+    v128_t v = wasm_f32x4_sub(wasm_v128_load(in + i), offsetV);
+    wasm_v128_store(out + i,
+                    wasm_f32x4_sub(baseV, wasm_f32x4_mul(v, scaleV)));
+  }
+#endif
+  for (; i < count; i++) {
+    out[i] = base - (in[i] - offset) * scale;
+  }
+}
+
+// Line segment vertices (pairs for RL_LINES) zig-zagging through a run of
+// columns at x = x0, x0 + 1, ...: each column contributes its low-high
+// segment, and from the second column on a segment joining the previous
+// column's high to its low first. Writes 2 + 4 * (count - 1) vertices and
+// returns that count. lowY/highY must not contain gaps.
+inline size_t buildColumnZigZag(float x0, const float *lowY,
+                                const float *highY, int count, Vector2 *out) {
+  if (count <= 0) {
+    return 0;
+  }
+
+  float *dst = &out[0].x;
+  dst[0] = x0;
+  dst[1] = lowY[0];
+  dst[2] = x0;
+  dst[3] = highY[0];
+  dst += 4;
+
+  int c = 1;
+#if defined(__wasm_simd128__)
+  // Four columns -> 16 vertices per iteration, interleaved with shuffles
+  v128_t step = wasm_f32x4_make(0.0f, 1.0f, 2.0f, 3.0f);
+  for (; c + 4 <= count; c += 4) {
+    v128_t x = wasm_f32x4_add(wasm_f32x4_splat(x0 + (float)c), step);
+    v128_t prevX = wasm_f32x4_sub(x, wasm_f32x4_splat(1.0f));
+    v128_t low = wasm_v128_load(lowY + c);
+    v128_t high = wasm_v128_load(highY + c);
+    v128_t prevHigh = wasm_v128_load(highY + c - 1);
+
+    // (x, y) pairs for columns 0-1 and 2-3 of each stream
+    v128_t prevHigh01 = wasm_i32x4_shuffle(prevX, prevHigh, 0, 4, 1, 5);
+    v128_t prevHigh23 = wasm_i32x4_shuffle(prevX, prevHigh, 2, 6, 3, 7);
+    v128_t low01 = wasm_i32x4_shuffle(x, low, 0, 4, 1, 5);
+    v128_t low23 = wasm_i32x4_shuffle(x, low, 2, 6, 3, 7);
+    v128_t high01 = wasm_i32x4_shuffle(x, high, 0, 4, 1, 5);
+    v128_t high23 = wasm_i32x4_shuffle(x, high, 2, 6, 3, 7);
+
+    // Per column: previous high, low, low, high
+    wasm_v128_store(dst, wasm_i32x4_shuffle(prevHigh01, low01, 0, 1, 4, 5));
+    wasm_v128_store(dst + 4, wasm_i32x4_shuffle(low01, high01, 0, 1, 4, 5));
+    wasm_v128_store(dst + 8, wasm_i32x4_shuffle(prevHigh01, low01, 2, 3, 6, 7));
+    wasm_v128_store(dst + 12, wasm_i32x4_shuffle(low01, high01, 2, 3, 6, 7));
+    wasm_v128_store(dst + 16, wasm_i32x4_shuffle(prevHigh23, low23, 0, 1, 4, 5));
+    wasm_v128_store(dst + 20, wasm_i32x4_shuffle(low23, high23, 0, 1, 4, 5));
+    wasm_v128_store(dst + 24, wasm_i32x4_shuffle(prevHigh23, low23, 2, 3, 6, 7));
+    wasm_v128_store(dst + 28, wasm_i32x4_shuffle(low23, high23, 2, 3, 6, 7));
+    dst += 32;
+  }
+#endif
+  for (; c < count; c++) {
+    float x = x0 + (float)c;
+    dst[0] = x - 1.0f;
+    dst[1] = highY[c - 1];
+    dst[2] = x;
+    dst[3] = lowY[c];
+    dst[4] = x;
+    dst[5] = lowY[c];
+    dst[6] = x;
+    dst[7] = highY[c];
+    dst += 8;
+  }
+
+  return 2 + 4 * (size_t)(count - 1);
+}